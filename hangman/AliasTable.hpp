@@ -0,0 +1,69 @@
+/*
+this class draws an index with probability proportional to its weight, in constant time
+it is Vose's alias method: the weights are spread over n columns of equal height, and
+every column holds at most two indices, its own and an alias; a draw picks a column
+uniformly, then one of its two indices with one comparison
+a column is a 32-bit threshold and a 32-bit alias, so the table costs 8 bytes per index
+*/
+
+#include <cstdint>
+#include <random>
+#include <vector>
+using namespace std;
+
+#ifndef ALIAS_TABLE_HPP
+#define ALIAS_TABLE_HPP
+
+class AliasTable {
+private:
+    vector<uint32_t> threshold; // a 32-bit random number below this keeps the column's own index
+    vector<uint32_t> alias; // the other index of the column
+
+public:
+    // Builds the table; returns false (and leaves it empty) if no weight is above 0
+    bool Build(const vector<double>& weights) {
+        threshold.clear();
+        alias.clear();
+        size_t n = weights.size();
+        double total = 0;
+        for (double w : weights) total += w > 0 ? w : 0;
+        if (n == 0 || !(total > 0)) return false;
+
+        // scaled so that the average column is 1
+        vector<double> scaled(n);
+        vector<uint32_t> small, large;
+        for (size_t i = 0; i < n; i++) {
+            scaled[i] = (weights[i] > 0 ? weights[i] : 0) * n / total;
+            (scaled[i] < 1 ? small : large).push_back(static_cast<uint32_t>(i));
+        }
+
+        threshold.assign(n, UINT32_MAX);
+        alias.resize(n);
+        for (size_t i = 0; i < n; i++) alias[i] = static_cast<uint32_t>(i);
+        while (!small.empty() && !large.empty()) {
+            uint32_t less = small.back(), more = large.back();
+            small.pop_back();
+            threshold[less] = static_cast<uint32_t>(scaled[less] * 4294967296.0);
+            alias[less] = more;
+            scaled[more] -= 1 - scaled[less];
+            if (scaled[more] < 1) {
+                large.pop_back();
+                small.push_back(more);
+            }
+        }
+        // what is left is 1 up to rounding, so those columns keep their own index
+        return true;
+    }
+
+    // Draws an index
+    uint32_t Sample(mt19937& rng) const {
+        uint32_t column = uniform_int_distribution<uint32_t>(0, static_cast<uint32_t>(threshold.size() - 1))(rng);
+        return rng() < threshold[column] ? column : alias[column];
+    }
+
+    size_t size() const { return threshold.size(); }
+    bool empty() const { return threshold.empty(); }
+    size_t MemoryBytes() const { return (threshold.capacity() + alias.capacity()) * sizeof(uint32_t); }
+};
+
+#endif // ALIAS_TABLE_HPP
@@ -0,0 +1,162 @@
+/*
+this class counts the memory the game allocates, per subsystem: the dictionary, the session
+state, rendering and saving/loading
+it is opt in: built with HANGMAN_TRACK_ALLOCS defined, the global operator new and delete are
+replaced by ones that put a 16 byte header in front of every block, holding its size and the
+subsystem it was allocated for; without it the tracker and its scopes compile to nothing
+a subsystem is picked with a scope, AllocScope scope(AllocTag::Rendering), which tags every
+allocation of the thread until it ends; scopes nest, and a block that is freed counts against
+the subsystem that allocated it, so live bytes stay right when ownership moves
+the replaced operators are defined in this header, so the program must include it from one
+source file only (the game is built from main.cpp alone)
+*/
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <new>
+#include <ostream>
+using namespace std;
+
+#ifndef ALLOC_TRACKER_HPP
+#define ALLOC_TRACKER_HPP
+
+enum class AllocTag : uint8_t { Other, Dictionary, Session, Rendering, SaveLoad };
+constexpr int ALLOC_TAGS = 5;
+
+// The allocations of one subsystem
+struct AllocCounts {
+    uint64_t allocations = 0, frees = 0;
+    uint64_t allocated = 0, freed = 0; // bytes
+
+    int64_t Live() const { return static_cast<int64_t>(allocated - freed); }
+};
+
+// The allocations of every subsystem, at a point in time or between two
+struct AllocReport {
+    AllocCounts tags[ALLOC_TAGS];
+
+    AllocReport operator-(const AllocReport& earlier) const {
+        AllocReport difference;
+        for (int t = 0; t < ALLOC_TAGS; t++) {
+            difference.tags[t].allocations = tags[t].allocations - earlier.tags[t].allocations;
+            difference.tags[t].frees = tags[t].frees - earlier.tags[t].frees;
+            difference.tags[t].allocated = tags[t].allocated - earlier.tags[t].allocated;
+            difference.tags[t].freed = tags[t].freed - earlier.tags[t].freed;
+        }
+        return difference;
+    }
+
+    // Prints one line per subsystem; with guesses, the allocations per guess too
+    void Print(ostream& out, const char* title, size_t guesses = 0) const {
+        static const char* const names[ALLOC_TAGS] = {"other", "dictionary", "session", "rendering", "save/load"};
+        out << title << ":" << endl;
+        for (int t = 0; t < ALLOC_TAGS; t++) {
+            const AllocCounts& c = tags[t];
+            out << "  " << left << setw(11) << names[t] << right << setw(10) << c.allocations << " allocations "
+                << setw(12) << c.allocated << " bytes " << setw(12) << c.Live() << " live";
+            if (guesses) out << "  " << fixed << setprecision(1) << double(c.allocations) / guesses << " per guess";
+            out << endl;
+        }
+    }
+};
+
+#ifdef HANGMAN_TRACK_ALLOCS
+
+class AllocTracker {
+private:
+    struct Counters {
+        atomic<uint64_t> allocations, frees, allocated, freed;
+    };
+    static inline Counters counters[ALLOC_TAGS];
+    static inline thread_local AllocTag current = AllocTag::Other;
+
+public:
+    static constexpr bool ENABLED = true;
+    static constexpr size_t HEADER = 16; // keeps the blocks aligned like malloc's
+
+    static void* Allocate(size_t size) {
+        void* block = malloc(size + HEADER);
+        if (!block) return nullptr;
+        uint64_t* header = static_cast<uint64_t*>(block);
+        header[0] = size;
+        header[1] = static_cast<uint64_t>(current);
+        Counters& c = counters[static_cast<int>(current)];
+        c.allocations.fetch_add(1, memory_order_relaxed);
+        c.allocated.fetch_add(size, memory_order_relaxed);
+        return static_cast<char*>(block) + HEADER;
+    }
+
+    static void Free(void* pointer) {
+        if (!pointer) return;
+        uint64_t* header = reinterpret_cast<uint64_t*>(static_cast<char*>(pointer) - HEADER);
+        Counters& c = counters[header[1]];
+        c.frees.fetch_add(1, memory_order_relaxed);
+        c.freed.fetch_add(header[0], memory_order_relaxed);
+        free(header);
+    }
+
+    // The counts so far
+    static AllocReport Snapshot() {
+        AllocReport report;
+        for (int t = 0; t < ALLOC_TAGS; t++) {
+            report.tags[t].allocations = counters[t].allocations.load(memory_order_relaxed);
+            report.tags[t].frees = counters[t].frees.load(memory_order_relaxed);
+            report.tags[t].allocated = counters[t].allocated.load(memory_order_relaxed);
+            report.tags[t].freed = counters[t].freed.load(memory_order_relaxed);
+        }
+        return report;
+    }
+
+    static AllocTag Current() { return current; }
+
+    // Tags the thread's allocations from now on, returns the tag it had
+    static AllocTag Swap(AllocTag tag) {
+        AllocTag previous = current;
+        current = tag;
+        return previous;
+    }
+};
+
+// Tags the thread's allocations until it ends
+class AllocScope {
+private:
+    AllocTag previous;
+
+public:
+    explicit AllocScope(AllocTag tag) : previous(AllocTracker::Swap(tag)) {}
+    ~AllocScope() { AllocTracker::Swap(previous); }
+    AllocScope(const AllocScope&) = delete;
+    AllocScope& operator=(const AllocScope&) = delete;
+};
+
+// The replaced operators; the nothrow and array forms of the library call these
+void* operator new(size_t size) {
+    if (void* block = AllocTracker::Allocate(size)) return block;
+    throw bad_alloc();
+}
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete(void* pointer) noexcept { AllocTracker::Free(pointer); }
+void operator delete[](void* pointer) noexcept { AllocTracker::Free(pointer); }
+void operator delete(void* pointer, size_t) noexcept { AllocTracker::Free(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { AllocTracker::Free(pointer); }
+
+#else
+
+class AllocTracker {
+public:
+    static constexpr bool ENABLED = false;
+    static AllocReport Snapshot() { return AllocReport(); }
+    static AllocTag Current() { return AllocTag::Other; }
+    static AllocTag Swap(AllocTag) { return AllocTag::Other; }
+};
+
+class AllocScope {
+public:
+    explicit AllocScope(AllocTag) {}
+};
+
+#endif // HANGMAN_TRACK_ALLOCS
+
+#endif // ALLOC_TRACKER_HPP
@@ -0,0 +1,181 @@
+/*
+this class plays the letter guesses of many sessions at once, for a host with thousands of players
+the sessions are kept as a struct of arrays: one array per field (letters guessed, hidden
+letters, word length, misses, guesses used, points), so a batch of guesses, one per session,
+is applied in one pass over contiguous arrays with no branches and no virtual calls, which
+the compiler turns into vector code (with AVX2, 8 or 16 sessions per instruction)
+how often each letter appears in each word is kept too (one byte per letter per session), so a
+guess finds how many letters it reveals with one lookup instead of walking the word; those
+lookups are a short scalar pass before the vector one
+points are the same as a HangmanRound's (and so HangmanScorer's), word by word, starting from 0;
+whole word guesses are rare, so they are played one session at a time
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "HangmanRound.hpp"
+#include "HangmanRules.hpp"
+using namespace std;
+
+#ifndef BATCH_GUESS_ENGINE_HPP
+#define BATCH_GUESS_ENGINE_HPP
+
+template <typename Rules>
+class BasicBatchGuessEngine {
+public:
+    using GuessResult = typename BasicHangmanRound<Rules>::GuessResult;
+    static constexpr size_t MAX_LENGTH = 255; // longer words are cut, the counts are bytes
+
+private:
+    using LetterMask = typename Rules::LetterMask;
+    static constexpr int LETTERS = Rules::ALPHABET_SIZE;
+
+    // hot fields, read and written by every guess
+    vector<LetterMask> guessed; // letters guessed, one bit each
+    vector<int32_t> hidden; // letters of the word still hidden
+    vector<int32_t> length; // letters in the word
+    vector<int32_t> misses; // wrong letters and words
+    vector<int32_t> used; // guesses that counted
+    vector<int32_t> points; // the points of the current word
+    vector<uint8_t> occurrences; // LETTERS counts per session: how often each letter is in the word
+
+    // scratch arrays of Apply, kept so a batch does not allocate
+    vector<int32_t> index, found;
+
+    // the results as ints, for the branch free step
+    static constexpr int32_t Correct = static_cast<int32_t>(GuessResult::Correct);
+    static constexpr int32_t Incorrect = static_cast<int32_t>(GuessResult::Incorrect);
+    static constexpr int32_t AlreadyGuessed = static_cast<int32_t>(GuessResult::AlreadyGuessed);
+    static constexpr int32_t RoundOver = static_cast<int32_t>(GuessResult::RoundOver);
+    static constexpr int32_t Invalid = static_cast<int32_t>(GuessResult::Invalid);
+
+    // cold fields
+    vector<string> words; // the words, for whole word guesses and the revealed letters
+
+    // Applies one guess to each of n sessions; every condition is a 0/1 value combined with & and *,
+    // so the loop has no branches, and __restrict tells the compiler the arrays never overlap, so
+    // it vectorizes without runtime checks
+    static void Step(size_t n, const int32_t* __restrict letter, const int32_t* __restrict found,
+                     LetterMask* __restrict g, int32_t* __restrict h, const int32_t* __restrict len,
+                     int32_t* __restrict m, int32_t* __restrict u, int32_t* __restrict p,
+                     GuessResult* __restrict out) {
+        for (size_t i = 0; i < n; i++) {
+            const int32_t valid = letter[i] >= 0;
+            const LetterMask bit = LetterMask(valid) << (letter[i] & ~(letter[i] >> 31)); // -1 shifts by 0
+            const int32_t over = (h[i] == 0) | (m[i] >= Rules::MAX_MISSES);
+            const int32_t repeated = (g[i] & bit) != 0;
+            const int32_t apply = valid & !over & !repeated;
+            const int32_t revealed = found[i] * apply;
+            const int32_t hit = revealed > 0;
+            const int32_t miss = apply & !hit;
+
+            g[i] |= bit * LetterMask(apply);
+            u[i] += apply;
+            h[i] -= revealed;
+            m[i] += miss;
+            const int32_t solved = hit & (h[i] == 0);
+            p[i] += hit * Rules::CORRECT_LETTER + miss * Rules::INCORRECT_LETTER +
+                    solved * (len[i] * Rules::WORD_LENGTH_BONUS + (Rules::MAX_MISSES - m[i]) * Rules::UNUSED_GUESS_BONUS +
+                              Rules::WIN_BONUS);
+            const int32_t result = over ? RoundOver : !valid ? Invalid : repeated ? AlreadyGuessed : hit ? Correct : Incorrect;
+            out[i] = static_cast<GuessResult>(result);
+        }
+    }
+
+public:
+    // Adds a session playing word, returns its id
+    uint32_t Add(string_view word) {
+        uint32_t id = static_cast<uint32_t>(words.size());
+        guessed.push_back(0);
+        hidden.push_back(0);
+        length.push_back(0);
+        misses.push_back(0);
+        used.push_back(0);
+        points.push_back(0);
+        occurrences.resize(occurrences.size() + LETTERS);
+        words.emplace_back();
+        Start(id, word);
+        return id;
+    }
+
+    // Starts a new word for a session; it must be lowercase letters
+    void Start(uint32_t id, string_view word) {
+        word = word.substr(0, MAX_LENGTH);
+        words[id].assign(word);
+        uint8_t* counts = &occurrences[size_t(id) * LETTERS];
+        fill(counts, counts + LETTERS, 0);
+        for (char c : word)
+            if (Rules::LetterIndex(c) >= 0) counts[Rules::LetterIndex(c)]++;
+        guessed[id] = 0;
+        hidden[id] = static_cast<uint8_t>(word.size());
+        length[id] = static_cast<uint8_t>(word.size());
+        misses[id] = 0;
+        used[id] = 0;
+        points[id] = 0;
+    }
+
+    // Applies letters[i] to session i, for every session; a letter that is not in the alphabet
+    // (0 for a session with no guess this time) changes nothing and gives Invalid
+    void Apply(span<const char> letters, span<GuessResult> results) {
+        const size_t n = min({letters.size(), results.size(), words.size()});
+
+        // first the letter of each guess and how often it is in the word; the lookups go to a
+        // different place for every session, so this pass stays scalar
+        index.resize(n);
+        found.resize(n);
+        for (size_t i = 0; i < n; i++) {
+            const int letter = Rules::LetterIndex(letters[i]);
+            index[i] = letter;
+            found[i] = occurrences[i * LETTERS + (letter >= 0 ? letter : 0)];
+        }
+        // then every field at once
+        Step(n, index.data(), found.data(), guessed.data(), hidden.data(), length.data(), misses.data(), used.data(),
+             points.data(), results.data());
+    }
+
+    // Guesses the whole word for one session; the caller checks that it is in the word list
+    GuessResult GuessWord(uint32_t id, string_view guess) {
+        if (IsOver(id)) return GuessResult::RoundOver;
+        used[id]++;
+        const string& word = words[id];
+        if (guess.size() != word.size() || !equal(guess.begin(), guess.end(), word.begin(),
+                [](char a, char b) { return Rules::LetterIndex(a) == Rules::LetterIndex(b); })) {
+            points[id] += Rules::INCORRECT_WORD;
+            misses[id]++;
+            return GuessResult::Incorrect;
+        }
+        points[id] += hidden[id] * Rules::CORRECT_WORD_PER_HIDDEN + length[id] * Rules::WORD_LENGTH_BONUS +
+                      (Rules::MAX_MISSES - misses[id]) * Rules::UNUSED_GUESS_BONUS + Rules::WIN_BONUS;
+        hidden[id] = 0;
+        return GuessResult::Correct;
+    }
+
+    size_t size() const { return words.size(); }
+
+    bool IsWon(uint32_t id) const { return length[id] > 0 && hidden[id] == 0; }
+    bool IsLost(uint32_t id) const { return hidden[id] > 0 && misses[id] >= Rules::MAX_MISSES; }
+    bool IsOver(uint32_t id) const { return IsWon(id) || IsLost(id); }
+
+    string_view GetWord(uint32_t id) const { return words[id]; }
+    int GetMisses(uint32_t id) const { return misses[id]; }
+    int GetGuessesLeft(uint32_t id) const { return Rules::MAX_MISSES - misses[id]; }
+    int GetGuessesUsed(uint32_t id) const { return used[id]; }
+    int GetScore(uint32_t id) const { return points[id]; }
+
+    // The word with '_' for the letters still hidden
+    string GetRevealed(uint32_t id) const {
+        string revealed = words[id];
+        if (hidden[id] == 0) return revealed;
+        for (char& c : revealed)
+            if (Rules::LetterIndex(c) < 0 || !(guessed[id] >> Rules::LetterIndex(c) & 1)) c = '_';
+        return revealed;
+    }
+};
+
+using BatchGuessEngine = BasicBatchGuessEngine<EnglishRules>;
+
+#endif // BATCH_GUESS_ENGINE_HPP
@@ -0,0 +1,260 @@
+/*
+this class plays scripted games without any screen, for testing and analytics
+every input line is one game, as a flat JSON object:
+  {"profile": "bob", "seed": 42, "guesses": "etaoin"}
+  {"profile": "bob", "word": "apple", "guesses": ["e", "a", "apply", "apple"]}
+the word is the first one a new profile is given after seeding the word list with seed (like
+in a recorded session), or is given directly; guesses are letters in a string, or an array where an
+entry longer than one letter guesses the whole word
+guesses are handled like in the game: anything that is not a letter, a letter already
+guessed and a word that is not in the list are skipped without costing anything
+every game writes one JSON line:
+  {"profile":"bob","word":"apple","outcome":"won","score":165,"guesses":4,"misses":1,"revealed":"apple"}
+outcome is won, lost, or unfinished when the guesses ran out first; a line that cannot be
+read writes {"line":n,"error":"..."} instead; a \u escape must be an ASCII character
+profiles are only echoed: nothing is loaded or saved, and the output is written in large blocks
+*/
+
+#include <cctype>
+#include <charconv>
+#include <cstdio>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "WordList.hpp"
+#include "HangmanRound.hpp"
+using namespace std;
+
+#ifndef BATCH_RUNNER_HPP
+#define BATCH_RUNNER_HPP
+
+template <typename Rules>
+class BasicBatchRunner {
+private:
+    static constexpr size_t FLUSH_BYTES = 1 << 16; // the output is written once it is this big
+
+    // One game read from a line
+    struct Script {
+        string profile;
+        bool has_seed = false;
+        uint32_t seed = 0;
+        string word;
+        vector<string> guesses;
+    };
+
+    WordList& wordlist; // the words, loaded once for every game
+    FILE* out; // where the results go
+    string buffer; // results not written yet
+    Script script; // the current game, kept so its strings are reused
+    BasicHangmanRound<Rules> round; // the game being played, reused for every game
+    SeenWords seen; // the words given, always none since every game is a new profile's
+    size_t games = 0; // games played
+    size_t errors = 0; // lines that could not be read
+
+    static void SkipSpace(string_view text, size_t& i) {
+        while (i < text.size() && (text[i] == ' ' || text[i] == '\t' || text[i] == '\r' || text[i] == '\n')) i++;
+    }
+
+    // Reads a JSON string starting at its opening quote; a \u escape outside ASCII fails it, since
+    // no letter of a word is
+    static bool ReadString(string_view text, size_t& i, string& value) {
+        value.clear();
+        if (i >= text.size() || text[i] != '"') return false;
+        for (i++; i < text.size(); i++) {
+            char c = text[i];
+            if (c == '"') {
+                i++;
+                return true;
+            }
+            if (c == '\\') {
+                if (++i >= text.size()) return false;
+                switch (text[i]) {
+                    case 'n': c = '\n'; break;
+                    case 't': c = '\t'; break;
+                    case 'r': c = '\r'; break;
+                    case 'b': c = '\b'; break;
+                    case 'f': c = '\f'; break;
+                    case 'u': {
+                        unsigned code = 0;
+                        if (i + 4 >= text.size()) return false;
+                        auto [end, ec] = from_chars(text.data() + i + 1, text.data() + i + 5, code, 16);
+                        if (ec != errc() || end != text.data() + i + 5 || code > 0x7f) return false;
+                        c = static_cast<char>(code);
+                        i += 4;
+                        break;
+                    }
+                    default: c = text[i]; break;
+                }
+            }
+            value += c;
+        }
+        return false;
+    }
+
+    // Skips a number, true, false or null
+    static bool SkipScalar(string_view text, size_t& i) {
+        size_t start = i;
+        while (i < text.size() && text[i] != ',' && text[i] != '}' && text[i] != ']' && text[i] != ' ') i++;
+        return i > start;
+    }
+
+    // Reads one line into script; returns an error message, or nullptr if it was read
+    const char* Parse(string_view text) {
+        script.profile.clear();
+        script.has_seed = false;
+        script.word.clear();
+        script.guesses.clear();
+
+        size_t i = 0;
+        string key, value;
+        SkipSpace(text, i);
+        if (i >= text.size() || text[i++] != '{') return "expected an object";
+        SkipSpace(text, i);
+        if (i < text.size() && text[i] == '}') return "empty object";
+        while (true) {
+            SkipSpace(text, i);
+            if (!ReadString(text, i, key)) return "expected a key";
+            SkipSpace(text, i);
+            if (i >= text.size() || text[i++] != ':') return "expected ':'";
+            SkipSpace(text, i);
+            if (i >= text.size()) return "expected a value";
+
+            if (key == "seed") {
+                auto [end, ec] = from_chars(text.data() + i, text.data() + text.size(), script.seed);
+                if (ec != errc()) return "seed must be a number";
+                i = end - text.data();
+                script.has_seed = true;
+            } else if (key == "guesses" && text[i] == '"') {
+                if (!ReadString(text, i, value)) return "unterminated string or bad escape";
+                for (char c : value) script.guesses.emplace_back(1, c);
+            } else if (key == "guesses" && text[i] == '[') {
+                for (i++;;) {
+                    SkipSpace(text, i);
+                    if (i < text.size() && text[i] == ']' && script.guesses.empty()) break;
+                    script.guesses.emplace_back();
+                    if (!ReadString(text, i, script.guesses.back())) return "guesses must be strings";
+                    SkipSpace(text, i);
+                    if (i < text.size() && text[i] == ',') { i++; continue; }
+                    if (i < text.size() && text[i] == ']') break;
+                    return "expected ',' or ']'";
+                }
+                i++;
+            } else if (text[i] == '"') {
+                if (!ReadString(text, i, key == "profile" ? script.profile : key == "word" ? script.word : value))
+                    return "unterminated string or bad escape";
+            } else if (text[i] == '{' || text[i] == '[') {
+                return "unexpected nested value";
+            } else if (!SkipScalar(text, i)) {
+                return "expected a value";
+            }
+
+            SkipSpace(text, i);
+            if (i < text.size() && text[i] == ',') { i++; continue; }
+            if (i < text.size() && text[i] == '}') break;
+            return "expected ',' or '}'";
+        }
+
+        if (!script.word.empty()) {
+            for (char& c : script.word) {
+                if (Rules::LetterIndex(c) < 0) return "word must be letters";
+                c = static_cast<char>(Rules::FIRST_LETTER + Rules::LetterIndex(c));
+            }
+        } else if (!script.has_seed) {
+            return "a seed or a word is needed";
+        }
+        return nullptr;
+    }
+
+    // Writes a string as a JSON string
+    void PutString(string_view value) {
+        buffer += '"';
+        for (char c : value) {
+            if (c == '"' || c == '\\') buffer += '\\';
+            if (static_cast<unsigned char>(c) < 0x20) c = ' ';
+            buffer += c;
+        }
+        buffer += '"';
+    }
+
+    void PutInt(long long value) {
+        char digits[24];
+        buffer.append(digits, to_chars(digits, digits + sizeof(digits), value).ptr);
+    }
+
+    void Flush() {
+        fwrite(buffer.data(), 1, buffer.size(), out);
+        buffer.clear();
+    }
+
+    // Plays the script's game and writes its result
+    void Play() {
+        if (script.word.empty()) {
+            wordlist.seed(script.seed);
+            seen = SeenWords();
+            script.word = wordlist.getRandomWord(seen); // the draw of Hangman::PlayRound
+        }
+        round.Start(script.word);
+        for (string& guess : script.guesses) {
+            if (round.IsOver()) break;
+            if (guess.size() > 1) { // the whole word
+                for (char& c : guess) c = static_cast<char>(tolower(c));
+                if (wordlist.contains(guess)) round.GuessWord(guess);
+            } else if (!guess.empty()) {
+                round.Guess(guess[0]);
+            }
+        }
+
+        buffer += "{\"profile\":";
+        PutString(script.profile);
+        buffer += ",\"word\":";
+        PutString(round.GetWord());
+        buffer += ",\"outcome\":";
+        buffer += round.IsWon() ? "\"won\"" : round.IsLost() ? "\"lost\"" : "\"unfinished\"";
+        buffer += ",\"score\":";
+        PutInt(round.GetScore());
+        buffer += ",\"guesses\":";
+        PutInt(round.GetGuessesUsed());
+        buffer += ",\"misses\":";
+        PutInt(round.GetMisses());
+        buffer += ",\"revealed\":";
+        PutString(round.GetRevealed());
+        buffer += "}\n";
+        games++;
+    }
+
+public:
+    BasicBatchRunner(WordList& words, FILE* output = stdout) : wordlist(words), out(output) {
+        buffer.reserve(FLUSH_BYTES * 2);
+    }
+
+    ~BasicBatchRunner() { Flush(); }
+
+    // Plays every line of input; blank lines are skipped
+    void Run(istream& input) {
+        string line;
+        for (size_t number = 1; getline(input, line); number++) {
+            if (line.find_first_not_of(" \t\r") == string::npos) continue;
+            if (const char* error = Parse(line)) {
+                buffer += "{\"line\":";
+                PutInt(static_cast<long long>(number));
+                buffer += ",\"error\":";
+                PutString(error);
+                buffer += "}\n";
+                errors++;
+            } else {
+                Play();
+            }
+            if (buffer.size() >= FLUSH_BYTES) Flush();
+        }
+        Flush();
+        fflush(out);
+    }
+
+    size_t GetGames() const { return games; }
+    size_t GetErrors() const { return errors; }
+};
+
+using BatchRunner = BasicBatchRunner<EnglishRules>;
+
+#endif // BATCH_RUNNER_HPP
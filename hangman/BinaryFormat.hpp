@@ -0,0 +1,165 @@
+/*
+helpers for the compact binary files of the game
+ByteWriter appends varints and length prefixed strings to a buffer,
+ByteReader reads them back without copying, Crc32 checks the bytes were not damaged
+*/
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+using namespace std;
+
+#ifndef BINARY_FORMAT_HPP
+#define BINARY_FORMAT_HPP
+
+// CRC-32 (the zlib polynomial), table built at compile time
+class Crc32 {
+private:
+    static constexpr array<uint32_t, 256> MakeTable() {
+        array<uint32_t, 256> table = {};
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            table[i] = c;
+        }
+        return table;
+    }
+
+public:
+    static uint32_t Compute(const uint8_t* data, size_t size, uint32_t crc = 0) {
+        static constexpr array<uint32_t, 256> table = MakeTable();
+        crc = ~crc;
+        for (size_t i = 0; i < size; i++) crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        return ~crc;
+    }
+};
+
+class ByteWriter {
+private:
+    vector<uint8_t> buffer; // the bytes written so far
+
+public:
+    // Unsigned values take 1 byte per 7 bits
+    void PutVarint(uint64_t value) {
+        while (value >= 0x80) {
+            buffer.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        buffer.push_back(static_cast<uint8_t>(value));
+    }
+
+    // Signed values are zigzag encoded, so small negative numbers stay small
+    void PutSigned(int64_t value) {
+        PutVarint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+    }
+
+    void PutString(string_view text) {
+        PutVarint(text.size());
+        buffer.insert(buffer.end(), text.begin(), text.end());
+    }
+
+    void PutRaw(const void* data, size_t size) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        buffer.insert(buffer.end(), bytes, bytes + size);
+    }
+
+    // Appends the CRC of everything written so far
+    void PutCrc() {
+        uint32_t crc = Crc32::Compute(buffer.data(), buffer.size());
+        for (int i = 0; i < 4; i++) buffer.push_back(static_cast<uint8_t>(crc >> (8 * i)));
+    }
+
+    const vector<uint8_t>& data() const { return buffer; }
+    vector<uint8_t>& data() { return buffer; }
+    void clear() { buffer.clear(); }
+};
+
+class ByteReader {
+private:
+    const uint8_t* pos; // next byte to read
+    const uint8_t* end; // one past the last byte
+
+public:
+    ByteReader(const uint8_t* data, size_t size) : pos(data), end(data + size) {}
+
+    bool GetVarint(uint64_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 64 && pos < end; shift += 7) {
+            uint8_t byte = *pos++;
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return true;
+        }
+        return false;
+    }
+
+    bool GetSigned(int64_t& value) {
+        uint64_t raw;
+        if (!GetVarint(raw)) return false;
+        value = static_cast<int64_t>(raw >> 1) ^ -static_cast<int64_t>(raw & 1);
+        return true;
+    }
+
+    // Reads an int that must fit, for fields stored as varints
+    bool GetInt(int& value) {
+        int64_t raw;
+        if (!GetSigned(raw) || raw < INT32_MIN || raw > INT32_MAX) return false;
+        value = static_cast<int>(raw);
+        return true;
+    }
+
+    // The returned view points into the reader's data
+    bool GetString(string_view& text) {
+        uint64_t size;
+        if (!GetVarint(size) || size > static_cast<uint64_t>(end - pos)) return false;
+        text = string_view(reinterpret_cast<const char*>(pos), size);
+        pos += size;
+        return true;
+    }
+
+    bool GetRaw(void* data, size_t size) {
+        if (size > static_cast<size_t>(end - pos)) return false;
+        copy(pos, pos + size, static_cast<uint8_t*>(data));
+        pos += size;
+        return true;
+    }
+
+    size_t remaining() const { return end - pos; }
+};
+
+// Reads a whole file with a single read, returns false if it cannot be opened
+inline bool ReadWholeFile(const string& filename, vector<uint8_t>& bytes) {
+    FILE* file = fopen(filename.c_str(), "rb");
+    if (!file) return false;
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    bytes.resize(size > 0 ? size : 0);
+    bool ok = size >= 0 && fread(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    fclose(file);
+    return ok;
+}
+
+// Writes a whole buffer with a single write
+inline bool WriteWholeFile(const string& filename, const vector<uint8_t>& bytes) {
+    FILE* file = fopen(filename.c_str(), "wb");
+    if (!file) return false;
+    bool ok = fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    return fclose(file) == 0 && ok;
+}
+
+// Checks the 4 byte CRC at the end of a buffer, which can be a mapped file
+inline bool CheckCrc(const uint8_t* bytes, size_t size) {
+    if (size < 4) return false;
+    size_t body = size - 4;
+    uint32_t stored = 0;
+    for (int i = 0; i < 4; i++) stored |= static_cast<uint32_t>(bytes[body + i]) << (8 * i);
+    return Crc32::Compute(bytes, body) == stored;
+}
+
+inline bool CheckCrc(const vector<uint8_t>& bytes) { return CheckCrc(bytes.data(), bytes.size()); }
+
+#endif // BINARY_FORMAT_HPP
@@ -0,0 +1,236 @@
+/*
+this class holds the precomputed best guess for every game state of a word list
+the builder plays the optimal strategy offline: for each word length it picks the letter
+with the highest information gain (how evenly it splits the remaining words by the positions
+it would reveal), then follows every possible answer, until the word is revealed or lost
+every state it reaches (revealed pattern + missed letters) is stored with its best letter
+
+file layout (little endian), usable straight from a memory mapping:
+  header: "HGDT", uint32 version, uint64 slot count (a power of two), uint64 dictionary fingerprint
+  slots:  uint64 state key, uint32 letter, uint32 unused; key 0 marks an empty slot
+the fingerprint is the one of the word list the tree was built from (see WordList::fingerprint);
+a tree is only opened for that word list, so one left over from an older list is not used
+the state key is a hash of the pattern and the missed letters, looked up with linear probing
+a state the tree does not hold (the player left the optimal path) is worked out at runtime
+instead, from the words that still fit the pattern
+it takes the rules of the game (HangmanRules.hpp) for the alphabet, its letter masks and the
+misses allowed; DecisionTree is the normal game's
+*/
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <algorithm>
+#include <bit>
+#include <numeric>
+#include "MappedFile.hpp"
+#include "WordList.hpp"
+#include "PatternIndex.hpp"
+#include "HangmanRules.hpp"
+using namespace std;
+
+#ifndef DECISION_TREE_HPP
+#define DECISION_TREE_HPP
+
+template <typename Rules>
+class BasicDecisionTree {
+public:
+    static constexpr uint32_t VERSION = 2;
+    using LetterMask = typename Rules::LetterMask;
+
+private:
+    struct Header {
+        char magic[4];
+        uint32_t version;
+        uint64_t slot_count;
+        uint64_t dictionary; // fingerprint of the word list
+    };
+
+    struct Slot {
+        uint64_t key;
+        uint32_t letter;
+        uint32_t unused;
+    };
+
+    MappedFile file; // the mapped tree file
+    const Slot* slots = nullptr; // the hash table inside the mapping
+    uint64_t slot_count = 0; // number of slots, a power of two
+
+    // Picks the letter not guessed yet that splits the candidates most evenly, -1 if there is none
+    static int BestSplit(const vector<string>& words, const vector<uint32_t>& candidates, LetterMask guessed) {
+        vector<uint64_t> masks(candidates.size());
+        int best_letter = -1;
+        double best_spread = 0;
+        size_t best_missing = 0;
+        for (int letter = 0; letter < Rules::ALPHABET_SIZE; letter++) {
+            if (guessed & (LetterMask(1) << letter)) continue;
+            for (size_t i = 0; i < candidates.size(); i++) {
+                const string& word = words[candidates[i]];
+                uint64_t mask = 0;
+                for (size_t p = 0; p < word.size(); p++)
+                    if (Rules::LetterIndex(word[p]) == letter) mask |= 1ull << p;
+                masks[i] = mask;
+            }
+            sort(masks.begin(), masks.end());
+
+            // sum of n * log(n) over the groups; smaller means more information
+            double spread = 0;
+            size_t missing = 0;
+            for (size_t i = 0, j; i < masks.size(); i = j) {
+                for (j = i; j < masks.size() && masks[j] == masks[i]; j++) {}
+                spread += (j - i) * log2(static_cast<double>(j - i));
+                if (masks[i] == 0) missing = j - i;
+            }
+            if (best_letter < 0 || spread < best_spread || (spread == best_spread && missing < best_missing)) {
+                best_letter = letter;
+                best_spread = spread;
+                best_missing = missing;
+            }
+        }
+        return best_letter;
+    }
+
+    // Builds the tree of one group of words; pattern uses '_' for hidden letters
+    static void Build(const vector<string>& words, const vector<uint32_t>& candidates, string& pattern,
+                      LetterMask missed, LetterMask guessed, int misses, int max_misses,
+                      unordered_map<uint64_t, char>& states) {
+        if (pattern.find('_') == string::npos || misses >= max_misses || candidates.empty()) return;
+
+        int best_letter = BestSplit(words, candidates, guessed);
+        if (best_letter < 0) return;
+        const char ch = static_cast<char>(Rules::FIRST_LETTER + best_letter);
+        const LetterMask bit = LetterMask(1) << best_letter;
+        states[Key(pattern, missed)] = ch;
+
+        // follows every answer the guess can get
+        unordered_map<uint64_t, vector<uint32_t>> groups;
+        for (uint32_t c : candidates) {
+            const string& word = words[c];
+            uint64_t mask = 0;
+            for (size_t p = 0; p < word.size(); p++)
+                if (Rules::LetterIndex(word[p]) == best_letter) mask |= 1ull << p;
+            groups[mask].push_back(c);
+        }
+        for (auto& group : groups) {
+            string next = pattern;
+            for (size_t p = 0; p < next.size(); p++)
+                if (group.first & (1ull << p)) next[p] = ch;
+            bool miss = group.first == 0;
+            Build(words, group.second, next, missed | (miss ? bit : 0), guessed | bit, misses + miss, max_misses,
+                  states);
+        }
+    }
+
+public:
+    // Hashes a game state; letters of the pattern are compared without case
+    static uint64_t Key(string_view pattern, LetterMask missed) {
+        uint64_t h = 14695981039346656037ull;
+        for (char c : pattern) {
+            h ^= static_cast<unsigned char>(tolower(c));
+            h *= 1099511628211ull;
+        }
+        h ^= static_cast<uint64_t>(missed) + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdull;
+        h ^= h >> 33;
+        return h ? h : 1; // 0 marks an empty slot
+    }
+
+    // Generates the tree for every word length of the word list and writes it to filename
+    static bool Generate(const WordList& wordlist, const string& filename, int max_misses = Rules::MAX_MISSES) {
+        vector<string> words = wordlist.getWords();
+        vector<vector<uint32_t>> by_length;
+        for (size_t i = 0; i < words.size(); i++) {
+            const string& word = words[i];
+            if (word.size() > 64 || any_of(word.begin(), word.end(), [](char c) { return Rules::LetterIndex(c) < 0; }))
+                continue; // only words of letters fit the letter and position masks
+            if (by_length.size() <= word.size()) by_length.resize(word.size() + 1);
+            by_length[word.size()].push_back(static_cast<uint32_t>(i));
+        }
+
+        unordered_map<uint64_t, char> states;
+        for (size_t length = 1; length < by_length.size(); length++) {
+            string pattern(length, '_');
+            Build(words, by_length[length], pattern, 0, 0, 0, max_misses, states);
+        }
+
+        uint64_t count = 1;
+        while (count < states.size() * 2) count <<= 1;
+        vector<Slot> table(count, Slot{0, 0, 0});
+        for (auto& state : states) {
+            uint64_t i = state.first & (count - 1);
+            while (table[i].key != 0) i = (i + 1) & (count - 1);
+            table[i] = Slot{state.first, static_cast<uint32_t>(state.second), 0};
+        }
+
+        ofstream out(filename, ios::binary);
+        if (!out.is_open()) return false;
+        Header header = {{'H', 'G', 'D', 'T'}, VERSION, count, wordlist.fingerprint()};
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(Slot));
+        return out.good();
+    }
+
+    // Maps a generated tree file, returns false if it is missing, not a tree, or built from another
+    // word list than the one of fingerprint dictionary
+    bool Open(const string& filename, uint64_t dictionary) {
+        slots = nullptr;
+        slot_count = 0;
+        if (!file.Open(filename) || file.size() < sizeof(Header)) return false;
+        Header header;
+        memcpy(&header, file.data(), sizeof(header));
+        // the slot count must be a power of two for the probing mask, and match the file size
+        // (divided, so a huge count cannot overflow into a match)
+        const size_t table_bytes = file.size() - sizeof(Header);
+        if (memcmp(header.magic, "HGDT", 4) != 0 || header.version != VERSION || header.dictionary != dictionary ||
+            !has_single_bit(header.slot_count) || table_bytes % sizeof(Slot) != 0 ||
+            table_bytes / sizeof(Slot) != header.slot_count) {
+            file.Close();
+            return false;
+        }
+        slots = reinterpret_cast<const Slot*>(file.data() + sizeof(Header));
+        slot_count = header.slot_count;
+        return true;
+    }
+
+    bool is_open() const { return slots != nullptr; }
+
+    // Returns the best next letter for a revealed pattern ('_' = hidden) and the missed letters, or 0 if unknown
+    char BestLetter(string_view pattern, LetterMask missed) const {
+        if (!slots) return 0;
+        uint64_t key = Key(pattern, missed);
+        uint64_t i = key & (slot_count - 1);
+        for (uint64_t probes = 0; probes < slot_count && slots[i].key != 0; probes++, i = (i + 1) & (slot_count - 1))
+            if (slots[i].key == key) return static_cast<char>(slots[i].letter);
+        return 0;
+    }
+
+    // Works out the best next letter at runtime, the way Generate does, for a state the tree does not
+    // hold: the words of the list that still fit (found with index, built from wordlist) are split by
+    // every letter not guessed yet; returns 0 if no word fits
+    static char ComputeBestLetter(const WordList& wordlist, const BasicPatternIndex<Rules>& index, string_view pattern,
+                                  LetterMask missed) {
+        vector<uint32_t> found = index.Match(pattern, missed);
+        if (found.empty() || pattern.size() > 64) return 0; // positions must fit a mask
+        LetterMask guessed = missed;
+        for (char c : pattern)
+            if (Rules::LetterIndex(c) >= 0) guessed |= LetterMask(1) << Rules::LetterIndex(c);
+
+        vector<string> words;
+        words.reserve(found.size());
+        for (uint32_t i : found) words.push_back(wordlist.word(i));
+        vector<uint32_t> candidates(words.size());
+        iota(candidates.begin(), candidates.end(), 0);
+        int letter = BestSplit(words, candidates, guessed);
+        return letter >= 0 ? static_cast<char>(Rules::FIRST_LETTER + letter) : 0;
+    }
+};
+
+using DecisionTree = BasicDecisionTree<EnglishRules>;
+
+#endif // DECISION_TREE_HPP
@@ -0,0 +1,147 @@
+/*
+this class measures how hard every word of a word list is, offline
+a reference solver plays each word many times: it keeps the words that still fit
+the revealed letters and picks its next letter with a chance proportional to how many
+of those words contain it; misses and wins are averaged over all the runs
+the results are written next to the dictionary as <word file>.difficulty,
+one "word expected_misses win_probability" line per word, in word list order
+it takes the rules of the game (HangmanRules.hpp) for the alphabet and the misses allowed;
+DifficultyAnalyzer is the normal game's
+*/
+
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "WordList.hpp"
+#include "HangmanRules.hpp"
+using namespace std;
+
+#ifndef DIFFICULTY_ANALYZER_HPP
+#define DIFFICULTY_ANALYZER_HPP
+
+template <typename Rules>
+class BasicDifficultyAnalyzer {
+private:
+    using LetterMask = typename Rules::LetterMask;
+
+    vector<string> words; // the words to analyze, decoded once
+    int trials; // number of games the solver plays per word
+    int max_misses; // misses allowed before a game is lost
+    vector<vector<uint32_t>> by_length; // word indices grouped by word length
+    vector<float> expected_misses; // result per word: average misses
+    vector<float> win_probability; // result per word: share of games won
+
+    // Plays one game against the word at target, returns the number of misses
+    int PlayOnce(uint32_t target, mt19937& rng, vector<uint32_t>& candidates) const {
+        const string& word = words[target];
+        candidates = by_length[word.size()];
+        LetterMask guessed = 0; // letters guessed so far, one bit per letter
+        size_t hidden = word.size();
+        int misses = 0;
+
+        while (hidden > 0 && misses < max_misses) {
+            // counts how many candidates contain each letter not guessed yet
+            int counts[Rules::ALPHABET_SIZE] = {};
+            for (uint32_t c : candidates) {
+                LetterMask seen = 0;
+                for (char ch : words[c])
+                    if (Rules::LetterIndex(ch) >= 0) seen |= LetterMask(1) << Rules::LetterIndex(ch);
+                seen &= ~guessed;
+                while (seen) {
+                    counts[countr_zero(seen)]++;
+                    seen &= seen - 1;
+                }
+            }
+
+            // picks a letter with a chance proportional to its count
+            int total = 0;
+            for (int count : counts) total += count;
+            int letter = 0;
+            if (total == 0) {
+                while (letter < Rules::ALPHABET_SIZE - 1 && (guessed & (LetterMask(1) << letter))) letter++;
+            } else {
+                int pick = uniform_int_distribution<int>(0, total - 1)(rng);
+                while (pick >= counts[letter]) pick -= counts[letter++];
+            }
+            guessed |= LetterMask(1) << letter;
+            auto is_letter = [letter](char ch) { return Rules::LetterIndex(ch) == letter; };
+
+            // keeps the candidates that show the letter at exactly the same positions
+            size_t kept = 0;
+            for (uint32_t c : candidates) {
+                const string& other = words[c];
+                bool fits = true;
+                for (size_t i = 0; i < word.size() && fits; i++)
+                    fits = is_letter(other[i]) == is_letter(word[i]);
+                if (fits) candidates[kept++] = c;
+            }
+            candidates.resize(kept);
+
+            size_t found = count_if(word.begin(), word.end(), is_letter);
+            if (found == 0) misses++;
+            hidden -= found;
+        }
+        return misses;
+    }
+
+public:
+    BasicDifficultyAnalyzer(const WordList& list, int trials_per_word = 32, int misses_allowed = Rules::MAX_MISSES)
+        : words(list.getWords()), trials(trials_per_word), max_misses(misses_allowed) {
+        for (size_t i = 0; i < words.size(); i++) {
+            size_t length = words[i].size();
+            if (by_length.size() <= length) by_length.resize(length + 1);
+            by_length[length].push_back(static_cast<uint32_t>(i));
+        }
+    }
+
+    // Runs the solver against every word, spread over all cores
+    void Run(unsigned threads = thread::hardware_concurrency()) {
+        expected_misses.assign(words.size(), 0);
+        win_probability.assign(words.size(), 0);
+        atomic<size_t> next(0);
+        const size_t chunk = 16;
+
+        auto worker = [&]() {
+            vector<uint32_t> candidates;
+            for (size_t begin; (begin = next.fetch_add(chunk)) < words.size();) {
+                size_t end = min(begin + chunk, words.size());
+                for (size_t i = begin; i < end; i++) {
+                    mt19937 rng(static_cast<uint32_t>(i)); // seeded per word, so runs are repeatable
+                    int misses = 0, wins = 0;
+                    for (int t = 0; t < trials; t++) {
+                        int m = PlayOnce(static_cast<uint32_t>(i), rng, candidates);
+                        misses += m;
+                        wins += m < max_misses;
+                    }
+                    expected_misses[i] = static_cast<float>(misses) / trials;
+                    win_probability[i] = static_cast<float>(wins) / trials;
+                }
+            }
+        };
+
+        vector<thread> pool;
+        for (unsigned t = 1; t < max(threads, 1u); t++) pool.emplace_back(worker);
+        worker();
+        for (thread& t : pool) t.join();
+    }
+
+    // Writes the difficulty column next to the dictionary
+    bool Save(const string& filename) const {
+        ofstream file(filename);
+        if (!file.is_open()) return false;
+        file << fixed << setprecision(3);
+        for (size_t i = 0; i < words.size(); i++)
+            file << words[i] << " " << expected_misses[i] << " " << win_probability[i] << "\n";
+        return true;
+    }
+};
+
+using DifficultyAnalyzer = BasicDifficultyAnalyzer<EnglishRules>;
+
+#endif // DIFFICULTY_ANALYZER_HPP
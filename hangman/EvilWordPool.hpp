@@ -0,0 +1,163 @@
+/*
+this class plays the word side of evil hangman: it never picks a word, it keeps every word
+that still fits what has been revealed, and after each guess keeps the biggest group
+the candidates of one length are copied side by side into one buffer, and the pool is a
+list of their offsets; a guess gives every candidate a signature (one bit per position
+where the letter is, found 8 letters at a time), counts the signatures in a flat hash map,
+and then compacts the list in place to the candidates of the biggest group
+every buffer is kept between guesses and words, so a guess does not allocate
+*/
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "WordList.hpp"
+using namespace std;
+
+#ifndef EVIL_WORD_POOL_HPP
+#define EVIL_WORD_POOL_HPP
+
+class EvilWordPool {
+public:
+    static constexpr size_t MAX_LENGTH = 64; // one signature bit per position
+
+private:
+    size_t length = 0; // the length of every candidate
+    vector<char> text; // the candidates' letters, length bytes each, and 8 bytes of padding
+    vector<uint32_t> candidates; // offsets into text of the words still possible
+    vector<uint64_t> signatures; // per candidate, the positions of the last letter guessed
+
+    // the flat hash map from signature to group size; a slot is used if its stamp is the current one
+    vector<uint64_t> keys;
+    vector<uint32_t> counts;
+    vector<uint32_t> stamps;
+    uint32_t stamp = 0;
+    vector<uint32_t> used; // the slots used by this guess
+
+    static uint64_t Hash(uint64_t signature) { return signature * 0x9E3779B97F4A7C15ull; }
+
+    // The positions of a word where letter is; every byte of 8 is compared at once
+    uint64_t Signature(const char* word, uint64_t letters) const {
+        constexpr uint64_t LOW7 = 0x7F7F7F7F7F7F7F7Full, HIGH = 0x8080808080808080ull;
+        uint64_t signature = 0;
+        for (size_t p = 0; p < length; p += 8) {
+            uint64_t chunk;
+            memcpy(&chunk, word + p, 8);
+            chunk ^= letters; // a zero byte where the letter is
+            uint64_t zero = ~(((chunk & LOW7) + LOW7) | chunk) & HIGH;
+            signature |= ((zero >> 7) * 0x0102040810204080ull >> 56) << p; // one bit per byte
+        }
+        return length < 64 ? signature & ((1ull << length) - 1) : signature;
+    }
+
+public:
+    // Starts a new word: every word of the list with the given length is a candidate
+    // returns false if there are none
+    bool Start(const WordList& wordlist, size_t word_length) {
+        length = word_length;
+        text.clear();
+        candidates.clear();
+        if (length == 0 || length > MAX_LENGTH) return false;
+        wordlist.forEach([this](size_t, string_view word) {
+            if (word.size() != length) return;
+            candidates.push_back(static_cast<uint32_t>(text.size()));
+            text.insert(text.end(), word.begin(), word.end());
+        });
+        text.resize(text.size() + 8, 0);
+        signatures.resize(candidates.size());
+
+        // there are at most 2^length signatures, so short words need only a small map
+        size_t groups = length < 32 ? min<size_t>(candidates.size(), size_t(1) << length) : candidates.size();
+        size_t slots = 16;
+        while (slots < groups * 2) slots <<= 1;
+        if (keys.size() != slots) {
+            keys.assign(slots, 0);
+            counts.assign(slots, 0);
+            stamps.assign(slots, 0);
+            stamp = 0;
+        }
+        return !candidates.empty();
+    }
+
+    // Splits the candidates by where letter appears and keeps the biggest group
+    // (fewest letters revealed on a tie); returns true if that group has the letter
+    bool Guess(char letter) {
+        if (candidates.empty()) return false;
+        if (++stamp == 0) { // the stamps wrapped around, so clear them once
+            fill(stamps.begin(), stamps.end(), 0);
+            stamp = 1;
+        }
+        size_t mask = keys.size() - 1;
+        int shift = 64 - countr_zero(keys.size());
+
+        // most candidates miss the letter, so that group is counted without the map
+        uint64_t letters = 0x0101010101010101ull * static_cast<unsigned char>(letter);
+        uint32_t missing = 0;
+        used.clear();
+        for (size_t c = 0; c < candidates.size(); c++) {
+            uint64_t signature = Signature(text.data() + candidates[c], letters);
+            signatures[c] = signature;
+            if (!signature) {
+                missing++;
+                continue;
+            }
+
+            size_t slot = Hash(signature) >> shift;
+            while (stamps[slot] == stamp && keys[slot] != signature) slot = (slot + 1) & mask;
+            if (stamps[slot] != stamp) {
+                stamps[slot] = stamp;
+                keys[slot] = signature;
+                counts[slot] = 0;
+                used.push_back(static_cast<uint32_t>(slot));
+            }
+            counts[slot]++;
+        }
+
+        // the biggest group; on a tie the one revealing fewer letters, then the smaller signature
+        uint64_t best = 0;
+        uint32_t best_count = missing;
+        for (uint32_t slot : used) {
+            uint64_t signature = keys[slot];
+            uint32_t count = counts[slot];
+            if (count > best_count || (count == best_count && best != 0 &&
+                    (popcount(signature) < popcount(best) || (popcount(signature) == popcount(best) && signature < best)))) {
+                best = signature;
+                best_count = count;
+            }
+        }
+
+        // keeps the biggest group, in place and in order
+        size_t kept = 0;
+        for (size_t c = 0; c < candidates.size(); c++)
+            if (signatures[c] == best) candidates[kept++] = candidates[c];
+        candidates.resize(kept);
+        return best != 0;
+    }
+
+    // Drops a candidate, so a guess of the whole word can be dodged; never drops the last one
+    // returns true if the word was dropped
+    bool Dodge(string_view word) {
+        if (candidates.size() < 2 || word.size() != length) return false;
+        for (size_t c = 0; c < candidates.size(); c++) {
+            if (string_view(text.data() + candidates[c], length) != word) continue;
+            candidates.erase(candidates.begin() + c);
+            return true;
+        }
+        return false;
+    }
+
+    // A word that fits everything revealed so far
+    string_view Representative() const {
+        return candidates.empty() ? string_view() : string_view(text.data() + candidates.front(), length);
+    }
+
+    size_t size() const { return candidates.size(); }
+    bool empty() const { return candidates.empty(); }
+    void clear() { candidates.clear(); }
+};
+
+#endif // EVIL_WORD_POOL_HPP
@@ -0,0 +1,165 @@
+/*
+this class stores a sorted word list as one front coded blob
+words are grouped in buckets of BUCKET; the first word of a bucket is stored whole, every
+other word only as the length of the prefix it shares with the word before it plus the rest
+a word is found by its rank (its position in sorted order) by decoding at most one bucket,
+and membership is a binary search over the bucket heads followed by one bucket scan
+bucket layout: varint length, bytes; then per word: varint shared prefix, varint rest length, rest bytes
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+using namespace std;
+
+#ifndef FRONT_CODED_DICTIONARY_HPP
+#define FRONT_CODED_DICTIONARY_HPP
+
+class FrontCodedDictionary {
+public:
+    static constexpr size_t BUCKET = 16; // words per bucket
+
+private:
+    vector<uint8_t> blob; // all the buckets, one after the other
+    vector<uint32_t> bucket_offsets; // where each bucket starts in the blob
+    size_t count = 0; // number of words
+
+    static void PutVarint(vector<uint8_t>& out, size_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    static size_t GetVarint(const uint8_t*& pos) {
+        size_t value = 0;
+        for (int shift = 0;; shift += 7) {
+            uint8_t byte = *pos++;
+            value |= static_cast<size_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return value;
+        }
+    }
+
+    // Compares a bucket's first word with a word, like string_view::compare
+    int CompareHead(size_t bucket, string_view word) const {
+        const uint8_t* pos = blob.data() + bucket_offsets[bucket];
+        size_t length = GetVarint(pos);
+        return string_view(reinterpret_cast<const char*>(pos), length).compare(word);
+    }
+
+public:
+    // Builds the blob; the words must be sorted and without repeats
+    void Build(const vector<string>& sorted_words) {
+        blob.clear();
+        bucket_offsets.clear();
+        count = sorted_words.size();
+        for (size_t i = 0; i < count; i++) {
+            const string& word = sorted_words[i];
+            if (i % BUCKET == 0) {
+                bucket_offsets.push_back(static_cast<uint32_t>(blob.size()));
+                PutVarint(blob, word.size());
+                blob.insert(blob.end(), word.begin(), word.end());
+                continue;
+            }
+            const string& previous = sorted_words[i - 1];
+            size_t shared = 0;
+            while (shared < word.size() && shared < previous.size() && word[shared] == previous[shared]) shared++;
+            PutVarint(blob, shared);
+            PutVarint(blob, word.size() - shared);
+            blob.insert(blob.end(), word.begin() + shared, word.end());
+        }
+        blob.shrink_to_fit();
+        bucket_offsets.shrink_to_fit();
+    }
+
+    size_t size() const { return count; }
+
+    // Decodes the word at a rank into out; out keeps its buffer, so reuse it to avoid allocating
+    void Get(size_t rank, string& out) const {
+        const uint8_t* pos = blob.data() + bucket_offsets[rank / BUCKET];
+        size_t length = GetVarint(pos);
+        out.assign(reinterpret_cast<const char*>(pos), length);
+        pos += length;
+        for (size_t k = rank % BUCKET; k > 0; k--) {
+            size_t shared = GetVarint(pos);
+            size_t rest = GetVarint(pos);
+            out.resize(shared);
+            out.append(reinterpret_cast<const char*>(pos), rest);
+            pos += rest;
+        }
+    }
+
+    string Get(size_t rank) const {
+        string word;
+        Get(rank, word);
+        return word;
+    }
+
+    // Checks if the word at a rank equals word, without decoding it into memory
+    bool Equals(size_t rank, string_view word) const {
+        const uint8_t* pos = blob.data() + bucket_offsets[rank / BUCKET];
+        size_t length = GetVarint(pos);
+        const char* bytes = reinterpret_cast<const char*>(pos);
+        // matched = how many leading characters of word the current word shares
+        size_t matched = 0;
+        while (matched < length && matched < word.size() && bytes[matched] == word[matched]) matched++;
+        pos += length;
+        for (size_t k = rank % BUCKET; k > 0; k--) {
+            size_t shared = GetVarint(pos);
+            size_t rest = GetVarint(pos);
+            bytes = reinterpret_cast<const char*>(pos);
+            pos += rest;
+            length = shared + rest;
+            // a shared prefix longer than the match keeps the same mismatch; otherwise compare the new part
+            if (shared <= matched) {
+                matched = shared;
+                while (matched < length && matched < word.size() && bytes[matched - shared] == word[matched]) matched++;
+            }
+        }
+        return matched == word.size() && length == word.size();
+    }
+
+    // Returns the rank of a word, or -1 if it is not in the dictionary
+    int64_t Find(string_view word) const {
+        if (count == 0) return -1;
+        // the last bucket whose head is <= word
+        size_t low = 0, high = bucket_offsets.size();
+        while (high - low > 1) {
+            size_t mid = (low + high) / 2;
+            if (CompareHead(mid, word) <= 0) low = mid; else high = mid;
+        }
+        size_t first = low * BUCKET, last = min(count, first + BUCKET);
+        for (size_t rank = first; rank < last; rank++)
+            if (Equals(rank, word)) return static_cast<int64_t>(rank);
+        return -1;
+    }
+
+    // Calls visit(rank, word) for every word in order, decoding each bucket once
+    template <typename Visit>
+    void ForEach(Visit visit) const {
+        string word;
+        const uint8_t* pos = blob.data();
+        for (size_t rank = 0; rank < count; rank++) {
+            if (rank % BUCKET == 0) {
+                size_t length = GetVarint(pos);
+                word.assign(reinterpret_cast<const char*>(pos), length);
+                pos += length;
+            } else {
+                size_t shared = GetVarint(pos);
+                size_t rest = GetVarint(pos);
+                word.resize(shared);
+                word.append(reinterpret_cast<const char*>(pos), rest);
+                pos += rest;
+            }
+            visit(rank, string_view(word));
+        }
+    }
+
+    // Bytes used by the dictionary itself
+    size_t MemoryBytes() const { return blob.capacity() + bucket_offsets.capacity() * sizeof(uint32_t); }
+};
+
+#endif // FRONT_CODED_DICTIONARY_HPP
@@ -0,0 +1,118 @@
+/*
+this struct holds a saved game and turns it into the binary save file and back
+layout: "HGSV", varint version, then every field as a varint or a length prefixed string,
+and a CRC-32 of all the bytes before it
+version 2 adds the words the profile has been given: varint dictionary size and the bitmap
+(see SeenWords); version 3 adds the fingerprint of the dictionary of that bitmap, so it is
+dropped for another word list; version 1 saves still load with no words seen, and version 2
+bitmaps, with no fingerprint, are dropped at the first draw
+old text profiles (one field per line) can still be imported
+*/
+
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "BinaryFormat.hpp"
+using namespace std;
+
+#ifndef GAME_SNAPSHOT_HPP
+#define GAME_SNAPSHOT_HPP
+
+struct GameSnapshot {
+    static constexpr uint64_t VERSION = 3;
+
+    string profile_name; // the player's name
+    int correct_words = 0; // the number of correctly guessed words
+    int guesses_left = 0; // guesses left for the current word
+    int guesses_used = 0; // guesses used for the current word
+    int score = 0; // total score
+    string word_to_guess; // the current word
+    string guessed_word; // the revealed letters, '_' for hidden ones
+    string incorrect_guesses; // the missed letters
+    uint64_t seen_count = 0; // the dictionary size of seen_words
+    string seen_words; // one bit per word already given, see SeenWords
+    uint64_t seen_dictionary = 0; // fingerprint of the dictionary of seen_words
+
+    // Encodes the snapshot into the binary save format
+    vector<uint8_t> Encode() const {
+        ByteWriter writer;
+        writer.PutRaw("HGSV", 4);
+        writer.PutVarint(VERSION);
+        writer.PutString(profile_name);
+        writer.PutSigned(correct_words);
+        writer.PutSigned(guesses_left);
+        writer.PutSigned(guesses_used);
+        writer.PutSigned(score);
+        writer.PutString(word_to_guess);
+        writer.PutString(guessed_word);
+        writer.PutString(incorrect_guesses);
+        writer.PutVarint(seen_count);
+        writer.PutString(seen_words);
+        writer.PutVarint(seen_dictionary);
+        writer.PutCrc();
+        return writer.data();
+    }
+
+    // Decodes a binary save, returns false if it is damaged or from an unknown version; the
+    // snapshot is only changed when the whole save decodes
+    bool Decode(const vector<uint8_t>& bytes) {
+        if (bytes.size() < 8 || memcmp(bytes.data(), "HGSV", 4) != 0 || !CheckCrc(bytes)) return false;
+        ByteReader reader(bytes.data() + 4, bytes.size() - 8);
+        GameSnapshot decoded;
+        uint64_t version;
+        string_view name, word, guessed, incorrect, seen;
+        if (!reader.GetVarint(version) || version < 1 || version > VERSION ||
+            !reader.GetString(name) ||
+            !reader.GetInt(decoded.correct_words) ||
+            !reader.GetInt(decoded.guesses_left) ||
+            !reader.GetInt(decoded.guesses_used) ||
+            !reader.GetInt(decoded.score) ||
+            !reader.GetString(word) ||
+            !reader.GetString(guessed) ||
+            !reader.GetString(incorrect))
+            return false;
+        if (version >= 2 && (!reader.GetVarint(decoded.seen_count) || !reader.GetString(seen))) return false;
+        if (version >= 3 && !reader.GetVarint(decoded.seen_dictionary)) return false;
+        if (reader.remaining() != 0 || guessed.size() != word.size()) return false; // trailing bytes, or a word that does not match its letters
+        decoded.profile_name = name;
+        decoded.word_to_guess = word;
+        decoded.guessed_word = guessed;
+        decoded.incorrect_guesses = incorrect;
+        decoded.seen_words = seen;
+        *this = move(decoded);
+        return true;
+    }
+
+    // Imports an old text profile: name, correct words, guesses left, score, word, guessed word, incorrect guesses
+    bool ImportText(const vector<uint8_t>& bytes) {
+        string_view text(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+        string_view lines[7];
+        for (int i = 0; i < 7; i++) {
+            size_t end = text.find('\n');
+            string_view line = text.substr(0, end);
+            if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+            lines[i] = line;
+            text = end == string_view::npos ? string_view() : text.substr(end + 1);
+        }
+
+        auto to_int = [](string_view field, int& value) {
+            return from_chars(field.data(), field.data() + field.size(), value).ec == errc();
+        };
+        if (lines[0].empty() || !to_int(lines[1], correct_words) || !to_int(lines[2], guesses_left) || !to_int(lines[3], score))
+            return false;
+        profile_name = lines[0];
+        word_to_guess = lines[4];
+        guessed_word = lines[5];
+        incorrect_guesses = lines[6];
+        guesses_used = 0;
+        seen_count = 0;
+        seen_words.clear();
+        seen_dictionary = 0;
+        return true;
+    }
+};
+
+#endif // GAME_SNAPSHOT_HPP
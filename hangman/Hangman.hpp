@@ -1,215 +1,466 @@
-#include "IHangman.hpp"
-#include "HangmanInterface.hpp"
-#include <iostream>
-#include <iomanip>
-#include <fstream>
-#include <algorithm> // for algorithms like find
-using namespace std;
-
-#ifndef HANGMAN_HPP
-#define HANGMAN_HPP
-
-class Hangman : public IHangman {
-private:
-    const int WIDTH = 50; // sets width for centering text using setw
-
-    // Private member functions
-    
-    // Takes the current guess from the user
-    void TakeInput() {
-        cout << endl << setw(WIDTH * 1.5) << "Enter a letter: ";
-        char letter;
-        cin >> letter;
-        SetGuessedLetter(letter);
-    }
-
-    // Updates the word to guess
-    void UpdateGuessedWord() {
-        SetWordToGuess(wordlist.getRandomWord()); // Updates the current word to guess
-        vector<char> new_guessed_word(GetWordToGuess().size(), '_'); // Fills the vector of guesses made so far with '_'
-        SetGuessedWord(new_guessed_word);
-    }
-
-    // Processes the user's guess
-    void ProcessGuess(char guess) {
-        bool correct = false;
-        vector<char> current_guessed_word = GetGuessedWord();
-        vector<char> current_incorrect_guesses = GetIncorrectGuesses();
-
-        // Check if the letter has already been guessed
-        if (find(current_guessed_word.begin(), current_guessed_word.end(), guess) != current_guessed_word.end() ||
-            find(current_incorrect_guesses.begin(), current_incorrect_guesses.end(), guess) != current_incorrect_guesses.end()) {
-            cout << "You've already guessed that letter. Try another one." << endl;
-            return;
-        }   
-
-        // Check if the guess is correct
-        for (size_t i = 0; i < GetWordToGuess().size(); i++) {
-            if (tolower(GetWordToGuess()[i]) == tolower(guess)) {
-                current_guessed_word[i] = GetWordToGuess()[i];
-                correct = true;
-            }
-        }
-
-        SetGuessedWord(current_guessed_word);
-
-        if (correct) {
-            hangman_scorer.CorrectGuess(guess);
-        } else {
-            hangman_scorer.IncorrectGuess();
-            vector<char> current_incorrect_guesses = GetIncorrectGuesses();
-            current_incorrect_guesses.push_back(guess);
-            SetIncorrectGuesses(current_incorrect_guesses);
-            SetGuessesLeft(GetGuessesLeft() - 1);
-        }
-        SetGuessesUsed(GetGuessesUsed() + 1);
-    }
-
-    // Converts a vector of chars to a string
-    string stringify(const vector<char>& vec) {
-        string result;
-        for (char c : vec) {
-            result += c;
-        }
-        return result;
-    }
-
-public:
-    // Constructor
-    Hangman() : IHangman("words.txt") {
-        hangman_interface = new HangmanInterface(this);
-        UpdateGuessedWord();
-    }
-
-    // Destructor
-    ~Hangman() {
-        delete hangman_interface;
-    }
-
-    // Public member functions
-    
-    // Starts the game
-    void PlayGame() {
-        hangman_interface->WelcomeScreen();
-    }
-
-    // Plays a round of the game
-    void PlayRound() override {
-        UpdateGuessedWord();
-        if (!IsGameLoaded()) {
-            SetGuessesLeft(6);
-            SetGuessesUsed(0);
-            SetIncorrectGuesses({});
-        } 
-        
-        while (GetGuessesLeft() > 0 && stringify(GetGuessedWord()) != GetWordToGuess()) {
-            hangman_interface->GameScreen();
-            TakeInput();
-            ProcessGuess(GetGuessedLetter());
-        }
-
-        string guessed_str = stringify(GetGuessedWord());
-        if (guessed_str == GetWordToGuess()) {
-            hangman_scorer.WordGuessed(GetWordToGuess());
-            SetCorrectWords(GetCorrectWords() + 1);
-            cout << setw(WIDTH * 1.5) << "\nCongratulations! You guessed the word: " << GetWordToGuess() << endl;
-            hangman_interface->Delay(1500);
-            SaveGame();
-            PlayRound();
-        } else {
-            cout << setw(WIDTH * 1.5) << "\nSorry, you ran out of guesses. The word was: " << GetWordToGuess() << endl;
-            hangman_interface->Delay(2000);
-            UpdateGuessedWord();
-            hangman_interface->MainMenu();
-        }
-        SetGameLoaded(false);
-    }
-
-    // Creates a user profile
-    void CreateProfile(const string& name) override {
-        SetProfileName(name);
-        SetCorrectWords(0);
-        SetGuessesLeft(6);
-        ofstream file(name + ".txt");
-        if (file.is_open()) {
-            file.close();
-            cout << "Profile " << name << " created successfully!" << endl;
-            cout << "\nSaving game.....\n";
-            hangman_interface->Delay(2000);
-            SaveGame();
-        } else {
-            cout << "Unable to create profile." << endl;
-            hangman_interface->ProfileMenu();
-        }
-    }
-
-    // Loads a user profile
-    void LoadProfile(const string& name) override {
-        ifstream file(name + ".txt");
-        if (file.is_open()) {
-            file.close();
-            SetProfileName(name);
-            cout << "Profile " << name << " loaded successfully!" << endl;
-        } else {
-            cout << "Profile " << name << " does not exist. Creating a new profile." << endl;
-            hangman_interface->Delay(2000);
-            CreateProfile(name);
-        }
-    }
-
-    // Saves the current game state
-    void SaveGame() override {
-        ofstream file(GetProfileName() + ".txt");
-        if (file.is_open()) {
-            file << GetProfileName() << "\n"
-                 << GetCorrectWords() << "\n"
-                 << GetGuessesLeft() << "\n"
-                 << GetScore() << "\n"
-                 << GetWordToGuess() << "\n";
-
-            for (char c : GetGuessedWord()) file << c;
-            file << "\n";
-            for (char c : GetIncorrectGuesses()) file << c;
-            file.close();
-            cout << "Game saved successfully!" << endl;
-            hangman_interface->Delay(2000);
-        } else {
-            cout << "Unable to open file for saving." << endl;
-        }
-    }
-
-    // Loads a previously saved game state
-    void LoadGame() override {
-        ifstream file(GetProfileName() + ".txt");
-        if (file.is_open()) {
-            string name;
-            int correct_words, guesses_left, score;
-            string word_to_guess;
-            string guessed_word_str, incorrect_guesses_str;
-
-            getline(file, name);
-            file >> correct_words >> guesses_left >> score;
-            file.ignore();
-            getline(file, word_to_guess);
-            getline(file, guessed_word_str);
-            getline(file, incorrect_guesses_str);
-
-            SetProfileName(name);
-            SetCorrectWords(correct_words);
-            SetGuessesLeft(guesses_left);
-            SetScore(score); 
-            SetWordToGuess(word_to_guess);
-            SetGuessedWord(vector<char>(guessed_word_str.begin(), guessed_word_str.end()));
-            SetIncorrectGuesses(vector<char>(incorrect_guesses_str.begin(), incorrect_guesses_str.end()));
-
-            SetGameLoaded(true);
-            cout << "Game loaded successfully!" << endl;
-            hangman_interface->Delay(2000);
-            PlayRound();
-        } else {
-            cout << "Unable to open file for loading." << endl;
-        }
-    }
-};
-
+#include "IHangman.hpp"
+#include "HangmanInterface.hpp"
+#include "DecisionTree.hpp"
+#include "GameSnapshot.hpp"
+#include "ProfileCache.hpp"
+#include "HangmanStats.hpp"
+#include "EvilWordPool.hpp"
+#include "HistoryArchive.hpp"
+#include "AllocTracker.hpp"
+#include <chrono>
+#include <thread>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <algorithm> // for algorithms like find
+using namespace std;
+
+#ifndef HANGMAN_HPP
+#define HANGMAN_HPP
+
+template <typename Rules>
+class BasicHangman final : public BasicIHangman<Rules> {
+private:
+    using Base = BasicIHangman<Rules>;
+    using LetterMask = typename Rules::LetterMask;
+    using Base::wordlist, Base::word_to_guess, Base::guessed_word, Base::incorrect_guesses, Base::hangman_scorer,
+          Base::hangman_interface, Base::profile_name, Base::io;
+
+    const int WIDTH = 50; // sets width for centering text using setw
+    string input; // the last input read, kept so reading a guess does not allocate
+    string word_guess; // the whole word guessed by the user, empty when a single letter was entered
+    BasicDecisionTree<Rules> hint_tree; // precomputed best guesses, used for hints when words.tree exists
+    bool hint_tree_opened = false; // words.tree is opened at the first hint
+    BasicPatternIndex<Rules> hint_index; // the words that fit a position, for hints the tree does not hold
+    bool hint_index_built = false; // hint_index is built at the first such hint
+    HangmanStats stats; // the current profile's statistics
+    LetterMask guessed_letters = 0; // every letter guessed for the current word, one bit each
+    EvilWordPool evil_pool; // the words still possible in evil mode, empty otherwise
+    ProfileCache profiles; // saved games, read once and written in batches
+    HistoryArchive history; // every finished round, for later analysis
+    bool history_chosen = false; // the caller picked the archive, so it is kept even when headless
+    SeenWords seen_words; // the words the profile has been given, so they do not come again
+    AllocReport session_start; // the allocation counts when the session started
+
+    // Rebuilds the guessed letter mask from the revealed and missed letters, after a load
+    void RebuildGuessedLetters() {
+        guessed_letters = 0;
+        for (char c : guessed_word)
+            if (Rules::LetterIndex(c) >= 0) guessed_letters |= LetterMask(1) << Rules::LetterIndex(c);
+        for (char c : incorrect_guesses)
+            if (Rules::LetterIndex(c) >= 0) guessed_letters |= LetterMask(1) << Rules::LetterIndex(c);
+    }
+
+    // Private member functions
+    
+    // Takes the guess just read, either a letter or the whole word
+    void TakeInput() {
+        if (input.size() > 1) {
+            word_guess = input;
+        } else {
+            word_guess.clear();
+            SetGuessedLetter(input.empty() ? ' ' : input[0]);
+        }
+    }
+
+    // Updates the word to guess
+    void UpdateGuessedWord() {
+        SetWordToGuess(wordlist->getRandomWord(seen_words)); // Updates the current word to guess
+        guessed_word.assign(word_to_guess.size(), '_'); // Fills the vector of guesses made so far with '_'
+        guessed_letters = 0;
+    }
+
+    // Drops the current word, so the next round deals a new one; the word is not drawn until then,
+    // so it is only marked as given when it is really played
+    void ClearWord() {
+        SetWordToGuess("");
+        guessed_word.clear();
+        guessed_letters = 0;
+    }
+
+    // Processes the user's guess; the state is updated in place
+    void ProcessGuess(char guess) {
+        bool correct = false;
+
+        const int index = Rules::LetterIndex(guess);
+        if (index < 0) {
+            io.Out() << "Please enter a letter." << endl;
+            return;
+        }
+
+        // Check if the letter has already been guessed
+        const LetterMask bit = LetterMask(1) << index;
+        if (guessed_letters & bit) {
+            io.Out() << "You've already guessed that letter. Try another one." << endl;
+            return;
+        }
+        guessed_letters |= bit;
+
+        // In evil mode the word is only chosen now: the biggest group of words left for this letter
+        if (!evil_pool.empty()) {
+            evil_pool.Guess(static_cast<char>(Rules::FIRST_LETTER + index));
+            SetWordToGuess(evil_pool.Representative());
+        }
+
+        // Check if the guess is correct
+        for (size_t i = 0; i < word_to_guess.size(); i++) {
+            if (Rules::LetterIndex(word_to_guess[i]) == index) {
+                guessed_word[i] = word_to_guess[i];
+                correct = true;
+            }
+        }
+
+        if (correct) {
+            hangman_scorer.CorrectGuess(guess);
+        } else {
+            hangman_scorer.IncorrectGuess();
+            incorrect_guesses.push_back(guess); // the capacity is reserved for a whole word's misses
+            SetGuessesLeft(GetGuessesLeft() - 1);
+        }
+        SetGuessesUsed(GetGuessesUsed() + 1);
+    }
+
+    // Processes a guess of the whole word
+    void ProcessWordGuess(string& guess) {
+        for (char& c : guess) c = tolower(c);
+
+        // Words that are not in the dictionary are rejected without costing a guess
+        if (!wordlist->contains(guess)) {
+            io.Out() << guess << " is not in the word list. Try another one." << endl;
+            return;
+        }
+
+        // In evil mode a word that is still possible is dropped, so the guess misses while any other word is left
+        if (!evil_pool.empty() && evil_pool.Dodge(guess)) SetWordToGuess(evil_pool.Representative());
+
+        if (word_to_guess.size() == guess.size() && equal(word_to_guess.begin(), word_to_guess.end(), guess.begin(),
+                [](char a, char b) { return tolower(a) == tolower(b); })) {
+            int hidden_letters = count(guessed_word.begin(), guessed_word.end(), '_');
+            hangman_scorer.CorrectWordGuess(hidden_letters);
+            copy(word_to_guess.begin(), word_to_guess.end(), guessed_word.begin());
+        } else {
+            hangman_scorer.IncorrectWordGuess();
+            SetGuessesLeft(GetGuessesLeft() - 1);
+        }
+        SetGuessesUsed(GetGuessesUsed() + 1);
+    }
+
+    // Shows the best next letter: from the precomputed decision tree, or worked out from the words
+    // that still fit when the tree does not hold this position or was built from other words
+    void ShowHint() {
+        if (!hint_tree_opened) { // now, as the tree is checked against the words, which may still be loading before
+            AllocScope scope(AllocTag::Dictionary);
+            hint_tree.Open("words.tree", wordlist->fingerprint());
+            hint_tree_opened = true;
+        }
+        LetterMask missed = 0;
+        for (char c : GetIncorrectGuesses())
+            if (Rules::LetterIndex(c) >= 0) missed |= LetterMask(1) << Rules::LetterIndex(c);
+        string_view pattern(guessed_word.data(), guessed_word.size());
+        char letter = hint_tree.BestLetter(pattern, missed);
+        if (!letter && wordlist->size() > 0) {
+            AllocScope scope(AllocTag::Dictionary);
+            if (!hint_index_built) {
+                hint_index.Build(wordlist.get());
+                hint_index_built = true;
+            }
+            letter = BasicDecisionTree<Rules>::ComputeBestLetter(wordlist.get(), hint_index, pattern, missed);
+        }
+        if (letter) {
+            io.Out() << setw(WIDTH * 1.5) << "Hint: try the letter " << letter << endl;
+        } else {
+            io.Out() << setw(WIDTH * 1.5) << "No hint for this position." << endl;
+        }
+    }
+
+    // Adds the round just finished to the history archive; a headless session, like a replay or a
+    // scripted run, plays rounds that are not real games, so it archives nothing unless told to
+    void RecordHistory(bool won, int score_before, int64_t milliseconds) {
+        if (io.IsHeadless() && !history_chosen) return;
+        AllocScope scope(AllocTag::SaveLoad);
+        RoundRecord round;
+        round.time = HistoryArchive::Now();
+        int id = wordlist->find(word_to_guess);
+        round.word = id >= 0 ? static_cast<uint32_t>(id) : UINT32_MAX; // UINT32_MAX: not in the dictionary
+        round.length = static_cast<uint32_t>(word_to_guess.size());
+        round.guessed = guessed_letters;
+        for (char c : incorrect_guesses)
+            if (Rules::LetterIndex(c) >= 0) round.missed |= uint64_t(1) << Rules::LetterIndex(c);
+        round.misses = static_cast<uint32_t>(Rules::MAX_MISSES - GetGuessesLeft());
+        round.guesses = static_cast<uint32_t>(GetGuessesUsed());
+        round.score = GetScore() - score_before;
+        round.duration = static_cast<uint32_t>(milliseconds);
+        round.won = won;
+        history.Append(round, wordlist->fingerprint());
+    }
+
+    // The current game state, as it is saved
+    GameSnapshot MakeSnapshot() const {
+        GameSnapshot snapshot;
+        snapshot.profile_name = GetProfileName();
+        snapshot.correct_words = GetCorrectWords();
+        snapshot.guesses_left = GetGuessesLeft();
+        snapshot.guesses_used = GetGuessesUsed();
+        snapshot.score = GetScore();
+        snapshot.word_to_guess = GetWordToGuess();
+        snapshot.guessed_word = stringify(GetGuessedWord());
+        snapshot.incorrect_guesses = stringify(GetIncorrectGuesses());
+        snapshot.seen_count = seen_words.size();
+        snapshot.seen_words = seen_words.Save();
+        snapshot.seen_dictionary = seen_words.GetDictionary();
+        return snapshot;
+    }
+
+    // Saves the game after a word is won; the profile cache writes it with the next batch, so a
+    // run of words is written once
+    void QueueSave() {
+        AllocScope scope(AllocTag::SaveLoad);
+        profiles.Put(MakeSnapshot());
+        switch (profiles.FlushIfDue()) {
+        case ProfileCache::FlushResult::NotDue:
+            io.Out() << "Game queued for saving." << endl;
+            break;
+        case ProfileCache::FlushResult::Written:
+            io.Out() << "Game saved successfully!" << endl;
+            break;
+        case ProfileCache::FlushResult::Failed:
+            io.Out() << "Unable to open file for saving." << endl;
+            break;
+        }
+    }
+
+    // The whole session, from the welcome screen until the input ends
+    SessionTask Session() {
+        session_start = AllocTracker::Snapshot();
+        co_await hangman_interface->WelcomeScreen();
+    }
+
+    // Converts a view of chars to a string
+    static string stringify(span<const char> vec) {
+        string result;
+        for (char c : vec) {
+            result += c;
+        }
+        return result;
+    }
+
+public:
+    // the state accessors of the base class, named here because the base depends on Rules
+    using Base::GetCorrectWords, Base::GetGuessedLetter, Base::GetGuessedWord, Base::GetGuessesLeft,
+          Base::GetGuessesUsed, Base::GetIncorrectGuesses, Base::GetProfileName, Base::GetScore,
+          Base::GetWordToGuess, Base::IsEvil, Base::IsGameLoaded, Base::IsWordGuessed;
+    using Base::SetCorrectWords, Base::SetEvil, Base::SetGameLoaded, Base::SetGuessedLetter, Base::SetGuessedWord,
+          Base::SetGuessesLeft, Base::SetGuessesUsed, Base::SetIncorrectGuesses, Base::SetProfileName,
+          Base::SetScore, Base::SetWordToGuess;
+
+    // Constructor
+    BasicHangman(WordList::Mode word_mode = WordList::Mode::InMemory,
+                 WordList::Difficulty difficulty = WordList::Difficulty::Any) : Base("words.txt", word_mode, difficulty) {
+        hangman_interface = new BasicHangmanInterface<Rules>(this);
+    }
+
+    // Constructor for one of many sessions of a host, which all play from the same words
+    explicit BasicHangman(WordList& words) : Base(words) {
+        hangman_interface = new BasicHangmanInterface<Rules>(this);
+    }
+
+    // Destructor
+    ~BasicHangman() {
+        delete hangman_interface;
+    }
+
+    // Public member functions
+    
+    // Starts the session on a scheduler, from the welcome screen, at the scheduler's next Run;
+    // the host then delivers its inputs to the returned id; the game must outlive the scheduler
+    uint32_t Start(SessionScheduler& scheduler) {
+        io.Attach(scheduler, scheduler.NextId());
+        return scheduler.Spawn(Session());
+    }
+
+    // Plays the game on the console, or the session being replayed: the session runs on a
+    // scheduler of its own, which is given an input whenever the session waits for one
+    void PlayGame() {
+        SessionScheduler scheduler;
+        const uint32_t id = Start(scheduler);
+        while (scheduler.size() > 0) {
+            scheduler.Run();
+            if (scheduler.IsWaiting(id)) {
+                if (io.Pull(input)) {
+                    scheduler.Deliver(id, input);
+                } else {
+                    scheduler.Close(id);
+                }
+            } else if (scheduler.size() > 0) {
+                this_thread::sleep_until(scheduler.NextWakeUp());
+            }
+        }
+    }
+
+    const HangmanStats& GetStats() const { return stats; }
+
+    // Archives the finished rounds to filename, "" for none, even when the session is headless
+    void SetHistoryFile(const string& filename) {
+        history.SetFile(filename);
+        history_chosen = true;
+    }
+
+    // What the session has allocated since it started, per subsystem (see AllocTracker)
+    AllocReport GetSessionAllocs() const { return AllocTracker::Snapshot() - session_start; }
+
+    // Records the session (the word seed and every input) to filename
+    bool RecordSession(const string& filename) {
+        uint32_t seed = random_device{}();
+        if (!io.StartRecording(filename, seed)) return false;
+        wordlist->seed(seed);
+        return true;
+    }
+
+    // Replays a recorded session headless; it draws the same words and makes the same guesses
+    // the profiles start empty and live in memory only, so a replay neither reads the saved games,
+    // which may have changed since it was recorded, nor writes over them, and every replay of a
+    // file plays the same
+    bool ReplaySession(const string& filename) {
+        uint32_t seed;
+        if (!io.StartReplay(filename, seed)) return false;
+        wordlist->seed(seed);
+        profiles.SetPersistent(false);
+        return true;
+    }
+
+    // Plays rounds of the game, a new word after each one won, until a word is lost or the input ends
+    Task PlayRound() override {
+        AllocScope scope(AllocTag::Session);
+        while (true) {
+            // a loaded game continues its word, unless that word was already finished
+            if (!IsGameLoaded() || GetWordToGuess().empty() || GetGuessedWord().size() != GetWordToGuess().size() ||
+                IsWordGuessed()) {
+                UpdateGuessedWord();
+                SetGuessesLeft(Rules::MAX_MISSES);
+                SetGuessesUsed(0);
+                SetIncorrectGuesses({});
+                if (IsEvil()) evil_pool.Start(wordlist.get(), word_to_guess.size());
+            }
+            if (!IsEvil()) evil_pool.clear();
+            SetGameLoaded(false);
+            RebuildGuessedLetters();
+            hangman_scorer.NewWord(Rules::MAX_MISSES - GetGuessesLeft());
+            const int score_before = GetScore();
+            auto word_start = chrono::steady_clock::now();
+
+            incorrect_guesses.reserve(incorrect_guesses.size() + GetGuessesLeft());
+            while (GetGuessesLeft() > 0 && !IsWordGuessed()) {
+                hangman_interface->GameScreen();
+                io.Out() << endl << setw(WIDTH * 1.5) << "Enter a letter or the whole word (? for a hint): ";
+                if (!co_await io.ReadToken(input)) co_return;
+                TakeInput();
+                if (!word_guess.empty()) {
+                    ProcessWordGuess(word_guess);
+                } else if (GetGuessedLetter() == '?') {
+                    ShowHint();
+                    co_await hangman_interface->Delay(1500);
+                } else {
+                    ProcessGuess(GetGuessedLetter());
+                }
+            }
+
+            bool won = IsWordGuessed();
+            auto word_time = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - word_start);
+            {
+                AllocScope saving(AllocTag::SaveLoad);
+                stats.RecordWord(won, Rules::MAX_MISSES - GetGuessesLeft(), GetGuessesUsed(), word_time.count());
+                profiles.PutStats(profile_name, stats.Encode()); // written with the profile's next batch
+            }
+
+            if (!won) {
+                RecordHistory(false, score_before, word_time.count());
+                {
+                    AllocScope saving(AllocTag::SaveLoad);
+                    history.Flush(); // the run of words is over, so its rounds are written together
+                    profiles.FlushIfDue();
+                }
+                io.Out() << setw(WIDTH * 1.5) << "\nSorry, you ran out of guesses. The word was: " << GetWordToGuess() << endl;
+                co_await hangman_interface->Delay(2000);
+                ClearWord();
+                co_return; // back to the main menu
+            }
+            hangman_scorer.WordGuessed(word_to_guess);
+            SetCorrectWords(GetCorrectWords() + 1);
+            RecordHistory(true, score_before, word_time.count());
+            io.Out() << setw(WIDTH * 1.5) << "\nCongratulations! You guessed the word: " << GetWordToGuess() << endl;
+            co_await hangman_interface->Delay(1500);
+            QueueSave();
+        }
+    }
+
+    // Creates a user profile
+    Task CreateProfile(const string& name) override {
+        AllocScope scope(AllocTag::SaveLoad);
+        SetProfileName(name);
+        stats.Clear();
+        seen_words = SeenWords(); // sized at the first draw, so this does not wait for the words
+        SetCorrectWords(0);
+        SetGuessesLeft(Rules::MAX_MISSES);
+        bool saved = profiles.Save(MakeSnapshot());
+        profiles.PutStats(name, stats.Encode()); // a new profile starts with no statistics
+        io.Out() << "Profile " << name << " created successfully!" << endl;
+        io.Out() << "\nSaving game.....\n";
+        co_await hangman_interface->Delay(2000);
+        io.Out() << (saved ? "Game saved successfully!" : "Unable to open file for saving.") << endl;
+        co_await hangman_interface->Delay(2000);
+    }
+
+    // Loads a user profile
+    Task LoadProfile(const string& name) override {
+        AllocScope scope(AllocTag::SaveLoad);
+        if (const GameSnapshot* saved = profiles.Find(name)) {
+            seen_words.Load(saved->seen_count, saved->seen_dictionary, saved->seen_words);
+            SetProfileName(name);
+            if (!stats.Decode(profiles.GetStats(name))) stats.Clear();
+            io.Out() << "Profile " << name << " loaded successfully!" << endl;
+        } else {
+            io.Out() << "Profile " << name << " does not exist. Creating a new profile." << endl;
+            co_await hangman_interface->Delay(2000);
+            co_await CreateProfile(name);
+        }
+    }
+
+    // Saves the current game state
+    Task SaveGame() override {
+        AllocScope scope(AllocTag::SaveLoad);
+        if (profiles.Save(MakeSnapshot())) {
+            io.Out() << "Game saved successfully!" << endl;
+            co_await hangman_interface->Delay(2000);
+        } else {
+            io.Out() << "Unable to open file for saving." << endl;
+        }
+    }
+
+    // Loads a previously saved game state, old text profiles are imported
+    Task LoadGame() override {
+        AllocScope scope(AllocTag::SaveLoad);
+        if (const GameSnapshot* saved = profiles.Find(profile_name)) {
+            const GameSnapshot& snapshot = *saved;
+            SetProfileName(snapshot.profile_name);
+            SetCorrectWords(snapshot.correct_words);
+            SetGuessesLeft(snapshot.guesses_left);
+            SetGuessesUsed(snapshot.guesses_used);
+            SetScore(snapshot.score);
+            SetWordToGuess(snapshot.word_to_guess);
+            SetGuessedWord(snapshot.guessed_word);
+            SetIncorrectGuesses(snapshot.incorrect_guesses);
+            seen_words.Load(snapshot.seen_count, snapshot.seen_dictionary, snapshot.seen_words);
+
+            SetGameLoaded(true);
+            io.Out() << "Game loaded successfully!" << endl;
+            co_await hangman_interface->Delay(2000);
+            co_await PlayRound();
+        } else {
+            io.Out() << "Unable to open file for loading." << endl;
+        }
+    }
+};
+
+using Hangman = BasicHangman<EnglishRules>;
+
 #endif // HANGMAN_HPP
\ No newline at end of file
@@ -1,179 +1,209 @@
-/*
-This class handles the game's interface
-it displays a welcome screen, the profile menu (to select profile);
-a main menu to start, load or save game
-and a game screen to guess a given word
-*/
-
-#include <iostream>
-#include <vector>
-#include <string>
-#include <iomanip>
-#include <algorithm> // for algorithms like find
-#include <chrono> // for timing
-#include <windows.h> // windows specific functionalities; setting text color
-#include "IHangman.hpp"
-using namespace std;
-
-#ifndef HANGMAN_INTERFACE_HPP
-#define HANGMAN_INTERFACE_HPP
-
-
-class HangmanInterface {
-private:
-    const int WIDTH = 50; // sets the width for centering text using setw
-    IHangman* hangman; // a pointer to IHangman object, the abstractt base class
-
-    // Method to display the keyboard
-    void DisplayKeyboard(const vector<char>& guessed, const vector<char>& incorrect_guesses) {
-        string upper_keys = "QWERTYUIOP";
-        string middle_keys = "ASDFGHJKL";
-        string lower_keys = "ZXCVBNM";
-
-        cout << "\n\n\n\n\n\n" << setw(WIDTH) << "";
-
-        // Display upper row keys
-        for (char key : upper_keys) {
-            if (find(guessed.begin(), guessed.end(), tolower(key)) != guessed.end()) {
-                SetColor(2); // Green for correct guess
-            } else if (find(incorrect_guesses.begin(), incorrect_guesses.end(), tolower(key)) != incorrect_guesses.end()) {
-                SetColor(4); // Red for incorrect guess
-            } else {
-                SetColor(8); // Gray for non-guessed letters
-            }
-            cout << key << "\t";
-        }
-        cout << "\n\n" << setw(WIDTH) << "";
-
-        // Display middle row keys with some padding at the start
-        cout << "   ";
-        for (char key : middle_keys) {
-            if (find(guessed.begin(), guessed.end(), tolower(key)) != guessed.end()) {
-                SetColor(2);
-            } else if (find(incorrect_guesses.begin(), incorrect_guesses.end(), tolower(key)) != incorrect_guesses.end()) {
-                SetColor(4);
-            } else {
-                SetColor(8);
-            }
-            cout << key << "\t";
-        }
-        cout << "\n\n" << setw(WIDTH) << "";
-
-        // Display lower row keys with more padding at the start
-        cout << "\t";
-        for (char key : lower_keys) {
-            if (find(guessed.begin(), guessed.end(), tolower(key)) != guessed.end()) {
-                SetColor(2);
-            } else if (find(incorrect_guesses.begin(), incorrect_guesses.end(), tolower(key)) != incorrect_guesses.end()) {
-                SetColor(4);
-            } else {
-                SetColor(8);
-            }
-            cout << key << "\t";
-        }
-        cout << "\n\n";
-        SetColor(7); // Reset to white color
-    }
-
-    // Method to select text color
-    void SetColor(int color) {SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), color);}
-
-public:
-    // constructor to initialize the Ihangman ppointer
-    HangmanInterface(IHangman* hangman_ptr): hangman(hangman_ptr) {}
-
-   void Delay(int milliseconds) {
-        Sleep(milliseconds);
-    }
-
-    // display a welcome screen onces the game starts
-    void WelcomeScreen() {
-        system("cls"); // clears the console
-        cout
-            << setw(WIDTH * 1.5) <<"....Welcome to Hangman!" << endl
-            << setw(WIDTH * 1.5) <<"Press Enter to start..." << endl;
-        cin.ignore();
-        Delay(1000); // 1-second delay
-        ProfileMenu(); // displays the profile menu
-    }
-
-    // Method to select user profile
-    void ProfileMenu() {
-
-        // checks if escaped has been pressed
-        while (true) {
-            system("cls");
-            cout
-                << "\n\n"
-                << "\tPress ESC to exit...\n\n"
-                << setw(WIDTH * 1.5) << "1. Select Profile\n"
-                << setw(WIDTH * 1.5) << "2. Create Profile\n";
-
-            // gets the user's choice
-            int choice;
-            cin >> choice;
-
-            if (choice == 1) {
-                cout << "Enter profile name: ";
-                string name;
-                cin >> name;
-                hangman->LoadProfile(name);
-                break;
-            } else if (choice == 2) {
-                cout << "Enter new profile name: ";
-                string name;
-                cin >> name;
-                hangman->CreateProfile(name);
-                break;
-            }
-        }
-        Delay(1000); // 1-second delay
-        MainMenu(); // displays the main menu afterwards
-    }
-
-    // Method to start a new game, load previous one or save the current one
-    void MainMenu() {
-        system("cls");
-        cout << "\n\n\n\n"
-            << setw(WIDTH * 1.5) << "1. New Game \n"
-            << setw(WIDTH * 1.5) << "2. Load Game\n";
-            // << setw(WIDTH * 1.5) << "3. Save Game\n";
-
-        // gets the user's choice
-        int choice;
-        cin >> choice;
-
-        if (choice == 1) { // New Game
-            hangman->PlayRound();
-        } else if (choice == 2) { // Load Game
-            hangman->LoadGame();
-        } else if (choice == 3) { // Save Game
-            hangman->SaveGame();
-        } else {
-            MainMenu(); // displays the main menu again if none of the choices is selected
-        }
-    }
-
-    // Method that displays the actual game screen: word to guess, keyboard, score, user profile, etc.
-    void GameScreen() {
-        system("cls");
-        // displays the game's header
-        cout
-            <<"\n\n\n\n"
-            << hangman->GetWordToGuess() << endl
-            << setw(WIDTH / 1.5) << "Profile: " << hangman->GetProfileName()
-            << setw(WIDTH / 1.5) << "Score: " << hangman->GetScore()
-            << setw(WIDTH / 1.5) << "Guesses left: " << hangman->GetGuessesLeft()
-            << setw(WIDTH / 1.5) << "Correct Words: " << hangman->GetCorrectWords()
-            << "\n\n\n\n";
-
-        // displays the current word
-        cout << "\n\n" << setw(WIDTH * 1.5) << "" << "Word: ";
-        for (auto letter : hangman->GetGuessedWord())
-            cout << letter << " ";
-        DisplayKeyboard(hangman->GetGuessedWord(), hangman->GetIncorrectGuesses());
-    }
-
-};
-
-#endif // HANGMAN_INTERFACE_HPP
+/*
+This class handles the game's interface
+it displays a welcome screen, the profile menu (to select profile);
+a main menu to start, load or save game
+and a game screen to guess a given word
+the menus wait for the player, so they are coroutines of the session (see SessionIO);
+the game screen only draws, so it is a plain function
+what the screens allocate is counted as rendering (see AllocTracker)
+*/
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <iomanip>
+#include <algorithm> // for algorithms like find
+#include <chrono> // for timing
+#include <cstdlib> // for system
+#include <windows.h> // windows specific functionalities; setting text color
+#include "SessionScheduler.hpp"
+#include "IHangman.hpp"
+#include "AllocTracker.hpp"
+using namespace std;
+
+#ifndef HANGMAN_INTERFACE_HPP
+#define HANGMAN_INTERFACE_HPP
+
+
+template <typename Rules>
+class BasicHangmanInterface {
+private:
+    const int WIDTH = 50; // sets the width for centering text using setw
+    BasicIHangman<Rules>* hangman; // a pointer to IHangman object, the abstractt base class
+    SessionIO& io; // the session's input and output
+
+    // Method to display the keyboard
+    void DisplayKeyboard(span<const char> guessed, span<const char> incorrect_guesses) {
+        string upper_keys = "QWERTYUIOP";
+        string middle_keys = "ASDFGHJKL";
+        string lower_keys = "ZXCVBNM";
+
+        io.Out() << "\n\n\n\n\n\n" << setw(WIDTH) << "";
+
+        // Display upper row keys
+        for (char key : upper_keys) {
+            if (find(guessed.begin(), guessed.end(), tolower(key)) != guessed.end()) {
+                SetColor(2); // Green for correct guess
+            } else if (find(incorrect_guesses.begin(), incorrect_guesses.end(), tolower(key)) != incorrect_guesses.end()) {
+                SetColor(4); // Red for incorrect guess
+            } else {
+                SetColor(8); // Gray for non-guessed letters
+            }
+            io.Out() << key << "\t";
+        }
+        io.Out() << "\n\n" << setw(WIDTH) << "";
+
+        // Display middle row keys with some padding at the start
+        io.Out() << "   ";
+        for (char key : middle_keys) {
+            if (find(guessed.begin(), guessed.end(), tolower(key)) != guessed.end()) {
+                SetColor(2);
+            } else if (find(incorrect_guesses.begin(), incorrect_guesses.end(), tolower(key)) != incorrect_guesses.end()) {
+                SetColor(4);
+            } else {
+                SetColor(8);
+            }
+            io.Out() << key << "\t";
+        }
+        io.Out() << "\n\n" << setw(WIDTH) << "";
+
+        // Display lower row keys with more padding at the start
+        io.Out() << "\t";
+        for (char key : lower_keys) {
+            if (find(guessed.begin(), guessed.end(), tolower(key)) != guessed.end()) {
+                SetColor(2);
+            } else if (find(incorrect_guesses.begin(), incorrect_guesses.end(), tolower(key)) != incorrect_guesses.end()) {
+                SetColor(4);
+            } else {
+                SetColor(8);
+            }
+            io.Out() << key << "\t";
+        }
+        io.Out() << "\n\n";
+        SetColor(7); // Reset to white color
+    }
+
+    // Method to select text color
+    void SetColor(int color) {
+        if (!io.IsHeadless()) SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), color);
+    }
+
+    // Method to clear the console
+    void ClearScreen() {
+        if (!io.IsHeadless()) system("cls");
+    }
+
+public:
+    // constructor to initialize the Ihangman ppointer
+    BasicHangmanInterface(BasicIHangman<Rules>* hangman_ptr): hangman(hangman_ptr), io(hangman_ptr->GetIO()) {}
+
+    // pauses the session: co_await Delay(1000)
+    SessionScheduler::SleepAwaiter Delay(int milliseconds) {
+        return io.Delay(chrono::milliseconds(milliseconds));
+    }
+
+    // display a welcome screen onces the game starts
+    Task WelcomeScreen() {
+        AllocScope scope(AllocTag::Rendering);
+        ClearScreen(); // clears the console
+        io.Out()
+            << setw(WIDTH * 1.5) <<"....Welcome to Hangman!" << endl
+            << setw(WIDTH * 1.5) <<"Press Enter to start..." << endl;
+        hangman->MarkFirstFrame();
+        if (!co_await io.WaitForEnter()) co_return;
+        co_await Delay(1000); // 1-second delay
+        co_await ProfileMenu(); // displays the profile menu
+    }
+
+    // Method to select user profile
+    Task ProfileMenu() {
+        AllocScope scope(AllocTag::Rendering);
+
+        // checks if escaped has been pressed
+        while (true) {
+            ClearScreen();
+            io.Out()
+                << "\n\n"
+                << "\tPress ESC to exit...\n\n"
+                << setw(WIDTH * 1.5) << "1. Select Profile\n"
+                << setw(WIDTH * 1.5) << "2. Create Profile\n";
+
+            // gets the user's choice
+            int choice;
+            if (!co_await io.ReadInt(choice)) co_return;
+
+            if (choice == 1) {
+                io.Out() << "Enter profile name: ";
+                string name;
+                if (!co_await io.ReadToken(name)) co_return;
+                co_await hangman->LoadProfile(name);
+                break;
+            } else if (choice == 2) {
+                io.Out() << "Enter new profile name: ";
+                string name;
+                if (!co_await io.ReadToken(name)) co_return;
+                co_await hangman->CreateProfile(name);
+                break;
+            }
+        }
+        co_await Delay(1000); // 1-second delay
+        co_await MainMenu(); // displays the main menu afterwards
+    }
+
+    // Method to start a new game, load previous one or save the current one
+    // the menu comes back after every choice, until the input runs out
+    Task MainMenu() {
+        AllocScope scope(AllocTag::Rendering);
+        while (!io.HasEnded()) {
+            ClearScreen();
+            io.Out() << "\n\n\n\n"
+                << setw(WIDTH * 1.5) << "1. New Game \n"
+                << setw(WIDTH * 1.5) << "2. Load Game\n"
+                << setw(WIDTH * 1.5) << "3. Evil Game\n";
+                // << setw(WIDTH * 1.5) << "4. Save Game\n";
+
+            // gets the user's choice
+            int choice;
+            if (!co_await io.ReadInt(choice)) co_return;
+
+            if (choice == 1) { // New Game
+                hangman->SetEvil(false);
+                co_await hangman->PlayRound();
+            } else if (choice == 2) { // Load Game
+                hangman->SetEvil(false);
+                co_await hangman->LoadGame();
+            } else if (choice == 3) { // Evil Game
+                hangman->SetEvil(true);
+                co_await hangman->PlayRound();
+            } else if (choice == 4) { // Save Game
+                co_await hangman->SaveGame();
+            } // displays the main menu again if none of the choices is selected
+        }
+    }
+
+    // Method that displays the actual game screen: word to guess, keyboard, score, user profile, etc.
+    void GameScreen() {
+        AllocScope scope(AllocTag::Rendering);
+        ClearScreen();
+        // displays the game's header
+        io.Out()
+            <<"\n\n\n\n"
+            << hangman->GetWordToGuess() << endl
+            << setw(WIDTH / 1.5) << "Profile: " << hangman->GetProfileName()
+            << setw(WIDTH / 1.5) << "Score: " << hangman->GetScore()
+            << setw(WIDTH / 1.5) << "Guesses left: " << hangman->GetGuessesLeft()
+            << setw(WIDTH / 1.5) << "Correct Words: " << hangman->GetCorrectWords()
+            << "\n\n\n\n";
+
+        // displays the current word
+        io.Out() << "\n\n" << setw(WIDTH * 1.5) << "" << "Word: ";
+        for (auto letter : hangman->GetGuessedWord())
+            io.Out() << letter << " ";
+        DisplayKeyboard(hangman->GetGuessedWord(), hangman->GetIncorrectGuesses());
+    }
+
+};
+
+using HangmanInterface = BasicHangmanInterface<EnglishRules>;
+
+#endif // HANGMAN_INTERFACE_HPP
@@ -0,0 +1,162 @@
+/*
+this class is a room where many players race on the same word
+the whole shared state (guessed letters, misses, version) is packed in one 64-bit word,
+so applying a guess is a single compare and swap, with no lock
+after every accepted guess the new state is encoded once into a frame; players poll the
+latest frame and all of them share that one buffer, nothing is copied per player
+every accepted guess adds a letter, so a room has at most one frame per letter of the alphabet
+plus the first one: they all get a place when the room is made, indexed by version, and each is
+written once, by the guess that made its version, before that version is published; publishing
+is a compare and swap on the latest version, so neither guesses nor polls ever take a lock, and
+a frame stays valid as long as the room, so a player can hold on to it
+scoring follows the rules like HangmanScorer: the letter points go to the guesser,
+and the word bonus to the player who completes the word
+
+frame bytes: varint version, varint guessed letters, varint misses, length prefixed pattern
+('_' for hidden letters), varint last player, last letter
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "BinaryFormat.hpp"
+#include "HangmanRules.hpp"
+using namespace std;
+
+#ifndef HANGMAN_ROOM_HPP
+#define HANGMAN_ROOM_HPP
+
+template <typename Rules>
+class BasicHangmanRoom {
+    static_assert(Rules::ALPHABET_SIZE <= 26, "the letters must fit the packed state");
+
+public:
+    enum class GuessResult { Correct, Incorrect, AlreadyGuessed, RoundOver, Invalid };
+
+    // One broadcast of the room state, shared by every player
+    struct Frame {
+        uint32_t version; // increases with every accepted guess
+        vector<uint8_t> bytes; // the encoded state
+    };
+
+private:
+    // layout of the packed state
+    static constexpr uint64_t LETTERS = (1ull << Rules::ALPHABET_SIZE) - 1; // low bits: guessed letters
+    static constexpr int MISS_SHIFT = 26; // bits 26-31: misses
+    static constexpr uint64_t MISS_ONE = 1ull << MISS_SHIFT;
+    static constexpr int VERSION_SHIFT = 32; // bits 32-63: version
+    static constexpr uint64_t VERSION_ONE = 1ull << VERSION_SHIFT;
+
+    const string word; // the word everyone is guessing
+    const uint64_t word_letters; // the letters of the word, one bit each
+    atomic<uint64_t> state{0}; // guessed letters, misses and version
+    vector<Frame> frames; // the frame of every version, written once each
+    atomic<uint32_t> latest{0}; // the version of the newest frame published
+    vector<atomic<int>> scores; // score of every player
+    atomic<int> players{0}; // number of players who joined
+
+    static int Misses(uint64_t packed) { return static_cast<int>((packed >> MISS_SHIFT) & 63); }
+
+    bool IsOver(uint64_t packed) const {
+        return Misses(packed) >= Rules::MAX_MISSES || (packed & word_letters) == word_letters;
+    }
+
+    static uint64_t LettersOf(const string& text) {
+        uint64_t letters = 0;
+        for (char c : text)
+            if (Rules::LetterIndex(c) >= 0) letters |= 1ull << Rules::LetterIndex(c);
+        return letters;
+    }
+
+    // Encodes a state once into the frame of its version; only the guess that made the version gets here
+    void Encode(uint64_t packed, int player, char letter) {
+        Frame* frame = &frames[packed >> VERSION_SHIFT];
+        frame->version = static_cast<uint32_t>(packed >> VERSION_SHIFT);
+        ByteWriter writer;
+        writer.PutVarint(frame->version);
+        writer.PutVarint(packed & LETTERS);
+        writer.PutVarint(Misses(packed));
+        writer.PutVarint(word.size());
+        for (char c : word)
+            writer.PutRaw((packed & (1ull << Rules::LetterIndex(c))) ? &c : "_", 1);
+        writer.PutVarint(static_cast<uint64_t>(player + 1));
+        writer.PutRaw(&letter, 1);
+        frame->bytes = move(writer.data());
+    }
+
+    // Makes an encoded version the latest, unless a newer one was published in the meantime
+    void Publish(uint32_t version) {
+        uint32_t current = latest.load(memory_order_relaxed);
+        while (current < version && !latest.compare_exchange_weak(current, version, memory_order_release,
+                                                                  memory_order_relaxed)) {}
+    }
+
+public:
+    // The word must be letters of the alphabet only
+    BasicHangmanRoom(const string& room_word, int capacity)
+        : word(room_word), word_letters(LettersOf(room_word)), frames(Rules::ALPHABET_SIZE + 1), scores(capacity) {
+        for (atomic<int>& score : scores) score.store(0, memory_order_relaxed);
+        Encode(0, -1, ' ');
+    }
+
+    // Adds a player, returns the player's id or -1 if the room is full
+    int Join() {
+        int id = players.fetch_add(1, memory_order_relaxed);
+        if (id >= static_cast<int>(scores.size())) {
+            players.fetch_sub(1, memory_order_relaxed);
+            return -1;
+        }
+        return id;
+    }
+
+    // Applies a guess with one compare and swap on the packed state, then broadcasts it
+    GuessResult Guess(int player, char letter) {
+        if (player < 0 || player >= min(players.load(memory_order_relaxed), static_cast<int>(scores.size())))
+            return GuessResult::Invalid;
+        int index = Rules::LetterIndex(letter);
+        if (index < 0) return GuessResult::Invalid;
+        uint64_t bit = 1ull << index;
+        bool hit = word_letters & bit;
+
+        uint64_t old_state = state.load(memory_order_acquire), new_state;
+        do {
+            if (IsOver(old_state)) return GuessResult::RoundOver;
+            if (old_state & bit) return GuessResult::AlreadyGuessed;
+            new_state = (old_state | bit) + (hit ? 0 : MISS_ONE) + VERSION_ONE;
+        } while (!state.compare_exchange_weak(old_state, new_state, memory_order_acq_rel, memory_order_acquire));
+
+        int points = hit ? Rules::CORRECT_LETTER : Rules::INCORRECT_LETTER;
+        if (hit && (new_state & word_letters) == word_letters)
+            points += static_cast<int>(word.size()) * Rules::WORD_LENGTH_BONUS +
+                      (Rules::MAX_MISSES - Misses(new_state)) * Rules::UNUSED_GUESS_BONUS + Rules::WIN_BONUS;
+        scores[player].fetch_add(points, memory_order_relaxed);
+
+        Encode(new_state, player, letter);
+        Publish(static_cast<uint32_t>(new_state >> VERSION_SHIFT));
+        return hit ? GuessResult::Correct : GuessResult::Incorrect;
+    }
+
+    // Returns the current frame, for players who just joined; it is valid as long as the room
+    const Frame* Latest() const { return &frames[latest.load(memory_order_acquire)]; }
+
+    // Returns the latest frame if it is newer than last_version, and updates last_version
+    const Frame* Poll(uint32_t& last_version) const {
+        uint32_t version = latest.load(memory_order_acquire);
+        if (version <= last_version) return nullptr;
+        last_version = version;
+        return &frames[version];
+    }
+
+    int GetScore(int player) const { return scores[player].load(memory_order_relaxed); }
+    int GetPlayers() const { return players.load(memory_order_relaxed); }
+    int GetMisses() const { return Misses(state.load(memory_order_acquire)); }
+    bool IsOver() const { return IsOver(state.load(memory_order_acquire)); }
+    bool IsSolved() const { return (state.load(memory_order_acquire) & word_letters) == word_letters; }
+    const string& GetWord() const { return word; }
+};
+
+using HangmanRoom = BasicHangmanRoom<EnglishRules>;
+
+#endif // HANGMAN_ROOM_HPP
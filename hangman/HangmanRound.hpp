@@ -0,0 +1,141 @@
+/*
+this class is one word of hangman without any screen: the word, what has been revealed,
+the misses and the points, scored with HangmanScorer
+it is what headless players use (the batch mode and the shared memory transport); it never
+allocates once the word buffers are big enough, so a round can be reused for every game
+the points are only this word's, starting from 0, and include the bonus once it is solved
+encoded: word, revealed, varint guessed letters, then misses, guesses used and points as signed varints
+*/
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include "HangmanRules.hpp"
+#include "HangmanScorer.hpp"
+#include "BinaryFormat.hpp"
+using namespace std;
+
+#ifndef HANGMAN_ROUND_HPP
+#define HANGMAN_ROUND_HPP
+
+template <typename Rules>
+class BasicHangmanRound {
+public:
+    enum class GuessResult { Correct, Incorrect, AlreadyGuessed, RoundOver, Invalid };
+
+private:
+    using LetterMask = typename Rules::LetterMask;
+
+    string word; // the word to guess, lowercase
+    string revealed; // the word with '_' for hidden letters
+    size_t hidden = 0; // letters still hidden
+    LetterMask guessed = 0; // letters guessed, one bit each
+    int misses = 0; // wrong letters and words
+    int used = 0; // guesses that counted
+    BasicHangmanScorer<Rules> scorer; // the points of this word
+
+    // Scores the solved word
+    void Solved() {
+        hidden = 0;
+        scorer.WordGuessed(word);
+    }
+
+public:
+    // Starts a new word; it must be lowercase letters
+    void Start(string_view new_word) {
+        word.assign(new_word);
+        revealed.assign(word.size(), '_');
+        hidden = word.size();
+        guessed = 0;
+        misses = 0;
+        used = 0;
+        scorer = BasicHangmanScorer<Rules>();
+        scorer.NewWord();
+    }
+
+    // Guesses a letter
+    GuessResult Guess(char letter) {
+        if (IsOver()) return GuessResult::RoundOver;
+        int index = Rules::LetterIndex(letter);
+        if (index < 0) return GuessResult::Invalid;
+        LetterMask bit = LetterMask(1) << index;
+        if (guessed & bit) return GuessResult::AlreadyGuessed;
+        guessed |= bit;
+        used++;
+
+        size_t found = 0;
+        for (size_t p = 0; p < word.size(); p++) {
+            if (Rules::LetterIndex(word[p]) != index) continue;
+            revealed[p] = word[p];
+            found++;
+        }
+        if (!found) {
+            scorer.IncorrectGuess();
+            misses++;
+            return GuessResult::Incorrect;
+        }
+        scorer.CorrectGuess(letter);
+        hidden -= found;
+        if (hidden == 0) Solved();
+        return GuessResult::Correct;
+    }
+
+    // Guesses the whole word; the caller checks that it is in the word list, like the game does
+    GuessResult GuessWord(string_view guess) {
+        if (IsOver()) return GuessResult::RoundOver;
+        used++;
+        if (guess.size() != word.size() || !equal(guess.begin(), guess.end(), word.begin(),
+                [](char a, char b) { return Rules::LetterIndex(a) == Rules::LetterIndex(b); })) {
+            scorer.IncorrectWordGuess();
+            misses++;
+            return GuessResult::Incorrect;
+        }
+        scorer.CorrectWordGuess(static_cast<int>(hidden));
+        revealed = word;
+        Solved();
+        return GuessResult::Correct;
+    }
+
+    // Writes the round, for checkpoints
+    void Encode(ByteWriter& writer) const {
+        writer.PutString(word);
+        writer.PutString(revealed);
+        writer.PutVarint(guessed);
+        writer.PutSigned(misses);
+        writer.PutSigned(used);
+        writer.PutSigned(scorer.GetScore());
+    }
+
+    // Reads a round written by Encode
+    bool Decode(ByteReader& reader) {
+        string_view saved_word, saved_revealed;
+        uint64_t letters;
+        int points;
+        if (!reader.GetString(saved_word) || !reader.GetString(saved_revealed) || !reader.GetVarint(letters) ||
+            !reader.GetInt(misses) || !reader.GetInt(used) || !reader.GetInt(points) ||
+            saved_word.size() != saved_revealed.size())
+            return false;
+        word.assign(saved_word);
+        revealed.assign(saved_revealed);
+        guessed = static_cast<LetterMask>(letters);
+        hidden = count(revealed.begin(), revealed.end(), '_');
+        scorer = BasicHangmanScorer<Rules>(points);
+        scorer.NewWord(misses);
+        return true;
+    }
+
+    bool IsWon() const { return !word.empty() && hidden == 0; }
+    bool IsLost() const { return hidden > 0 && misses >= Rules::MAX_MISSES; }
+    bool IsOver() const { return IsWon() || IsLost(); }
+
+    string_view GetWord() const { return word; }
+    string_view GetRevealed() const { return revealed; }
+    int GetMisses() const { return misses; }
+    int GetGuessesLeft() const { return Rules::MAX_MISSES - misses; }
+    int GetGuessesUsed() const { return used; }
+    int GetScore() const { return scorer.GetScore(); }
+};
+
+using HangmanRound = BasicHangmanRound<EnglishRules>;
+
+#endif // HANGMAN_ROUND_HPP
@@ -0,0 +1,51 @@
+/*
+the rules of the game, as compile time policies
+a rules struct gives the misses allowed, the scoring table and the alphabet;
+the game classes take it as a template parameter, so every rule is a constant the compiler
+can fold, and letter sets fit in a fixed width mask sized for the alphabet
+EnglishRules is the normal game; other rule sets derive from it and change what they need
+*/
+
+#include <cstdint>
+#include <type_traits>
+using namespace std;
+
+#ifndef HANGMAN_RULES_HPP
+#define HANGMAN_RULES_HPP
+
+// The smallest unsigned type with one bit per letter of an alphabet
+template <int AlphabetSize>
+using LetterMaskFor = conditional_t<(AlphabetSize <= 32), uint32_t, uint64_t>;
+
+struct EnglishRules {
+    static constexpr int MAX_MISSES = 6; // misses allowed before the word is lost
+
+    // scoring table
+    static constexpr int CORRECT_LETTER = 10; // a letter that is in the word
+    static constexpr int INCORRECT_LETTER = -5; // a letter that is not
+    static constexpr int CORRECT_WORD_PER_HIDDEN = 10; // guessing the whole word, per letter still hidden
+    static constexpr int INCORRECT_WORD = -10; // a wrong whole word
+    static constexpr int WORD_LENGTH_BONUS = 5; // per letter of a solved word
+    static constexpr int UNUSED_GUESS_BONUS = 10; // per miss left when the word is solved
+    static constexpr int WIN_BONUS = 50; // for every solved word
+
+    // alphabet: consecutive letters starting at FIRST_LETTER, compared without case
+    static constexpr int ALPHABET_SIZE = 26;
+    static constexpr char FIRST_LETTER = 'a';
+    using LetterMask = LetterMaskFor<ALPHABET_SIZE>;
+
+    // Returns the position of a letter in the alphabet, or -1 if it is not a letter
+    static constexpr int LetterIndex(char c) {
+        if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+        int index = c - FIRST_LETTER;
+        return index >= 0 && index < ALPHABET_SIZE ? index : -1;
+    }
+};
+
+// A shorter game: only 4 misses, and solving with misses to spare is worth more
+struct HardRules : EnglishRules {
+    static constexpr int MAX_MISSES = 4;
+    static constexpr int UNUSED_GUESS_BONUS = 20;
+};
+
+#endif // HANGMAN_RULES_HPP
@@ -1,59 +1,83 @@
-/*
-this class is used to score the hangman game
-+10 for correctly guessing a letter, -5 for wrong guess
-word length * 5 for correctly guessing the word,
-unused guesses * 10 and extra 50
-*/
-
-#include <string>
-using namespace std;
-
-
-#ifndef HangmanScorer_HPP
-#define HangmanScorer_HPP
-class HangmanScorer {
-private:
-    int points; // total points / score accumulated
-    int correct_guesses; // number of correct guesses
-    int incorrect_guesses; // number of incorrect guesses
-    int correct_words; // number of correctly guessed words
-
-public:
-    // Constructor to initialize the points and guesses
-    HangmanScorer(int initial_points = 0)
-        : points(initial_points), correct_guesses(0), incorrect_guesses(0), correct_words(0) {}
-
-    // Method to handle a correct guess
-    void CorrectGuess(char letter) {
-        points += 10;
-        correct_guesses++;
-    }
-    
-    // Method to handle an incorrect guess
-    void IncorrectGuess() {
-        points -= 5;
-        incorrect_guesses++;
-    }
-
-    // Method to handle the word being guessed
-    void WordGuessed(const string& word) {
-        int wordLengthBonus = word.length() * 5; // score for correctly guessing a word
-        points += wordLengthBonus; 
-
-        int unusedGuessesBonus = (6 - incorrect_guesses) * 10; // unused guessed bonus
-        points += unusedGuessesBonus;
-
-        points += 50;  // Winning bonus
-    }
-    
-    // Method to get the current score
-    int GetScore() const {return points;}
-    
-    // Method to get the number of correctly guessed words
-    int GetCorrectWords() const {return correct_words;}
-
-    // Method to set the score / points
-    void SetScore(int score) {this->points = score;}
-};
-
+/*
+this class is used to score the hangman game
+the points come from the rules (see HangmanRules.hpp); with EnglishRules:
++10 for correctly guessing a letter, -5 for wrong guess
+word length * 5 for correctly guessing the word,
+unused guesses * 10 and extra 50
+guessing the whole word: +10 for every letter still hidden, -10 and a lost guess if it is wrong
+*/
+
+#include <string_view>
+#include "HangmanRules.hpp"
+using namespace std;
+
+
+#ifndef HangmanScorer_HPP
+#define HangmanScorer_HPP
+template <typename Rules>
+class BasicHangmanScorer {
+private:
+    int points; // total points / score accumulated
+    int correct_guesses; // number of correct guesses
+    int incorrect_guesses; // number of incorrect guesses
+    int correct_words; // number of correctly guessed words
+
+public:
+    // Constructor to initialize the points and guesses
+    BasicHangmanScorer(int initial_points = 0)
+        : points(initial_points), correct_guesses(0), incorrect_guesses(0), correct_words(0) {}
+
+    // Method to start counting a new word; misses already made on it count against the bonus
+    void NewWord(int misses_so_far = 0) {
+        incorrect_guesses = misses_so_far;
+    }
+
+    // Method to handle a correct guess
+    void CorrectGuess(char) {
+        points += Rules::CORRECT_LETTER;
+        correct_guesses++;
+    }
+
+    // Method to handle an incorrect guess
+    void IncorrectGuess() {
+        points += Rules::INCORRECT_LETTER;
+        incorrect_guesses++;
+    }
+
+    // Method to handle a correct guess of the whole word
+    void CorrectWordGuess(int hidden_letters) {
+        points += hidden_letters * Rules::CORRECT_WORD_PER_HIDDEN;
+        correct_guesses++;
+    }
+
+    // Method to handle a wrong guess of the whole word
+    void IncorrectWordGuess() {
+        points += Rules::INCORRECT_WORD;
+        incorrect_guesses++;
+    }
+
+    // Method to handle the word being guessed
+    void WordGuessed(string_view word) {
+        int wordLengthBonus = static_cast<int>(word.length()) * Rules::WORD_LENGTH_BONUS; // score for correctly guessing a word
+        points += wordLengthBonus;
+
+        int unusedGuessesBonus = (Rules::MAX_MISSES - incorrect_guesses) * Rules::UNUSED_GUESS_BONUS; // unused guessed bonus
+        points += unusedGuessesBonus;
+
+        points += Rules::WIN_BONUS;  // Winning bonus
+        correct_words++;
+    }
+
+    // Method to get the current score
+    int GetScore() const {return points;}
+
+    // Method to get the number of correctly guessed words
+    int GetCorrectWords() const {return correct_words;}
+
+    // Method to set the score / points
+    void SetScore(int score) {this->points = score;}
+};
+
+using HangmanScorer = BasicHangmanScorer<EnglishRules>;
+
 #endif
\ No newline at end of file
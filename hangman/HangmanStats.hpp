@@ -0,0 +1,113 @@
+/*
+this class keeps the statistics of a profile: words won and lost, and histograms of
+misses per word, guesses needed to solve a word and time spent per word
+the counters are split in shards, one cache line block per shard, and every thread adds to
+its own shard with a relaxed atomic add; reading sums the shards, so updating never locks
+saved as <profile>.stats, written with the profile's game (see ProfileCache): "HGST", varint version, varint counter count, one varint per counter, CRC-32
+*/
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+#include "BinaryFormat.hpp"
+using namespace std;
+
+#ifndef HANGMAN_STATS_HPP
+#define HANGMAN_STATS_HPP
+
+class HangmanStats {
+public:
+    static constexpr int MISS_BUCKETS = 8; // 0 to 7 misses
+    static constexpr int GUESS_BUCKETS = 32; // 0 to 31 guesses, longer games count as 31
+    static constexpr int TIME_BUCKETS = 24; // bucket b holds times below 2^b milliseconds
+
+private:
+    static constexpr int WON = 0;
+    static constexpr int LOST = 1;
+    static constexpr int MISSES = 2;
+    static constexpr int GUESSES = MISSES + MISS_BUCKETS;
+    static constexpr int TIMES = GUESSES + GUESS_BUCKETS;
+    static constexpr int COUNTERS = TIMES + TIME_BUCKETS;
+    static constexpr int SHARDS = 16;
+    static constexpr uint64_t VERSION = 1;
+
+    struct alignas(64) Shard {
+        atomic<uint64_t> counts[COUNTERS];
+    };
+    Shard shards[SHARDS]; // each thread adds to one shard, so threads rarely share a cache line
+
+    // Picks the shard of the calling thread
+    static int ShardIndex() {
+        static thread_local int index = static_cast<int>(hash<thread::id>()(this_thread::get_id()) % SHARDS);
+        return index;
+    }
+
+    void Add(int counter, uint64_t amount = 1) {
+        shards[ShardIndex()].counts[counter].fetch_add(amount, memory_order_relaxed);
+    }
+
+    uint64_t Total(int counter) const {
+        uint64_t total = 0;
+        for (const Shard& shard : shards) total += shard.counts[counter].load(memory_order_relaxed);
+        return total;
+    }
+
+    static int Clamp(int value, int buckets) { return value < 0 ? 0 : value >= buckets ? buckets - 1 : value; }
+
+public:
+    HangmanStats() { Clear(); }
+
+    // Records a finished word
+    void RecordWord(bool won, int misses, int guesses, uint64_t milliseconds) {
+        Add(won ? WON : LOST);
+        Add(MISSES + Clamp(misses, MISS_BUCKETS));
+        if (won) Add(GUESSES + Clamp(guesses, GUESS_BUCKETS));
+        int time_bucket = 0;
+        while (time_bucket < TIME_BUCKETS - 1 && (milliseconds >> time_bucket) != 0) time_bucket++;
+        Add(TIMES + time_bucket);
+    }
+
+    uint64_t GetWordsWon() const { return Total(WON); }
+    uint64_t GetWordsLost() const { return Total(LOST); }
+    uint64_t GetMissesHistogram(int misses) const { return Total(MISSES + Clamp(misses, MISS_BUCKETS)); }
+    uint64_t GetGuessesHistogram(int guesses) const { return Total(GUESSES + Clamp(guesses, GUESS_BUCKETS)); }
+    uint64_t GetTimeHistogram(int bucket) const { return Total(TIMES + Clamp(bucket, TIME_BUCKETS)); }
+
+    void Clear() {
+        for (Shard& shard : shards)
+            for (atomic<uint64_t>& count : shard.counts) count.store(0, memory_order_relaxed);
+    }
+
+    // Encodes the totals; most counters are small, so they take a byte each
+    vector<uint8_t> Encode() const {
+        ByteWriter writer;
+        writer.PutRaw("HGST", 4);
+        writer.PutVarint(VERSION);
+        writer.PutVarint(COUNTERS);
+        for (int i = 0; i < COUNTERS; i++) writer.PutVarint(Total(i));
+        writer.PutCrc();
+        return writer.data();
+    }
+
+    // Decodes saved totals, returns false if they are missing or damaged
+    bool Decode(const vector<uint8_t>& bytes) {
+        if (bytes.size() < 8 || memcmp(bytes.data(), "HGST", 4) != 0 || !CheckCrc(bytes))
+            return false;
+        ByteReader reader(bytes.data() + 4, bytes.size() - 8);
+        uint64_t version, count;
+        if (!reader.GetVarint(version) || version != VERSION || !reader.GetVarint(count) || count != COUNTERS)
+            return false;
+        vector<uint64_t> totals(COUNTERS);
+        for (uint64_t& total : totals)
+            if (!reader.GetVarint(total)) return false;
+        Clear();
+        for (int i = 0; i < COUNTERS; i++) shards[0].counts[i].store(totals[i], memory_order_relaxed);
+        return true;
+    }
+};
+
+#endif // HANGMAN_STATS_HPP
@@ -0,0 +1,282 @@
+/*
+this class keeps the history of every finished round in a columnar archive, for questions
+like "the miss rate of the letter e on 7 letter words over the last month"
+finished rounds are buffered in memory and appended to the archive a block at a time; a
+block stores each field as its own column of varints, and the times as deltas, so a round
+costs 10 to 20 bytes
+every block carries the fingerprint of the dictionary its word ids are ranks in (see
+WordList::fingerprint); a load keeps only the blocks of the dictionary it is given and counts
+the rounds it skipped, so ids are never read against another word list
+a query loads the columns into flat arrays and scans them with branch free loops that the
+compiler turns into vector code: the filters build a selection of 0/1 bytes, and the sums
+multiply by it instead of branching
+
+archive layout: a sequence of blocks, each one "HGHB", varint body size, the body, and a
+CRC-32 of the body; a body is varint version, varint dictionary fingerprint, varint row count,
+then the columns in order:
+  time (seconds since 1970, the first one as is and the rest as signed deltas),
+  word id (rank in the dictionary), word length, letters guessed (one bit per letter),
+  letters missed, misses, guesses used, score change (signed), duration in milliseconds, won
+a damaged block ends the archive when it is read, so a crash while appending loses only that block
+an archive with no file name keeps nothing: its rounds are dropped as they are appended
+version 1 blocks have no fingerprint; they are counted as another dictionary's
+*/
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "BinaryFormat.hpp"
+#include "MappedFile.hpp"
+using namespace std;
+
+#ifndef HISTORY_ARCHIVE_HPP
+#define HISTORY_ARCHIVE_HPP
+
+// One finished round
+struct RoundRecord {
+    int64_t time = 0; // when it ended, seconds since 1970
+    uint32_t word = 0; // the word's rank in the dictionary
+    uint32_t length = 0; // letters in the word
+    uint64_t guessed = 0; // every letter guessed, one bit each
+    uint64_t missed = 0; // the guessed letters that were not in the word
+    uint32_t misses = 0; // misses used, letters and whole words
+    uint32_t guesses = 0; // guesses made
+    int32_t score = 0; // how much the score changed
+    uint32_t duration = 0; // milliseconds spent on the word
+    bool won = false;
+};
+
+// The archive loaded as columns, one array per field
+struct HistoryColumns {
+    vector<int64_t> time;
+    vector<uint32_t> word, length;
+    vector<uint64_t> guessed, missed;
+    vector<uint32_t> misses, guesses;
+    vector<int32_t> score;
+    vector<uint32_t> duration;
+    vector<uint8_t> won;
+    uint64_t other_dictionary = 0; // rounds skipped because they were played with another dictionary
+
+    size_t size() const { return time.size(); }
+};
+
+// Which rounds a query looks at; a field left at its default does not filter
+struct HistoryFilter {
+    uint32_t length = 0; // only words of this length
+    int64_t since = INT64_MIN; // only rounds that ended at or after this time
+    int letter = -1; // only rounds where this letter (its bit) was guessed
+};
+
+// What a query found
+struct HistorySummary {
+    uint64_t rounds = 0, won = 0;
+    uint64_t misses = 0, guesses = 0, duration = 0;
+    int64_t score = 0;
+    uint64_t letter_missed = 0; // of the rounds, those where the filter's letter missed
+};
+
+class HistoryArchive {
+public:
+    static constexpr uint64_t VERSION = 2;
+    static constexpr size_t BLOCK_ROWS = 4096; // rounds buffered before a block is written
+
+private:
+    string filename;
+    uint64_t dictionary = 0; // fingerprint of the dictionary the pending rounds' word ids belong to
+    vector<RoundRecord> pending; // rounds not written yet
+
+    // Encodes the pending rounds as one block
+    void EncodeBlock(ByteWriter& block) const {
+        ByteWriter body;
+        body.PutVarint(VERSION);
+        body.PutVarint(dictionary);
+        body.PutVarint(pending.size());
+        int64_t previous = 0;
+        for (const RoundRecord& r : pending) {
+            body.PutSigned(r.time - previous);
+            previous = r.time;
+        }
+        for (const RoundRecord& r : pending) body.PutVarint(r.word);
+        for (const RoundRecord& r : pending) body.PutVarint(r.length);
+        for (const RoundRecord& r : pending) body.PutVarint(r.guessed);
+        for (const RoundRecord& r : pending) body.PutVarint(r.missed);
+        for (const RoundRecord& r : pending) body.PutVarint(r.misses);
+        for (const RoundRecord& r : pending) body.PutVarint(r.guesses);
+        for (const RoundRecord& r : pending) body.PutSigned(r.score);
+        for (const RoundRecord& r : pending) body.PutVarint(r.duration);
+        for (const RoundRecord& r : pending) body.PutVarint(r.won);
+
+        block.PutRaw("HGHB", 4);
+        block.PutVarint(body.data().size());
+        block.PutRaw(body.data().data(), body.data().size());
+        uint32_t crc = Crc32::Compute(body.data().data(), body.data().size());
+        for (int i = 0; i < 4; i++) block.data().push_back(static_cast<uint8_t>(crc >> (8 * i)));
+    }
+
+    // Reads count values of a column into out, converted to its type
+    template <typename T>
+    static bool GetColumn(ByteReader& reader, uint64_t count, vector<T>& out) {
+        for (uint64_t i = 0; i < count; i++) {
+            uint64_t value;
+            if (!reader.GetVarint(value)) return false;
+            out.push_back(static_cast<T>(value));
+        }
+        return true;
+    }
+
+    // Appends the rows of one block body to columns, or only counts them if they belong to another
+    // dictionary than the expected one; false if it does not decode
+    static bool DecodeBlock(const uint8_t* bytes, size_t size, uint64_t expected, HistoryColumns& columns) {
+        ByteReader reader(bytes, size);
+        uint64_t version, fingerprint = 0, count;
+        if (!reader.GetVarint(version) || version < 1 || version > VERSION) return false;
+        if (version >= 2 && !reader.GetVarint(fingerprint)) return false;
+        if (!reader.GetVarint(count) || count > size) return false;
+        if (version < 2 || fingerprint != expected) {
+            columns.other_dictionary += count;
+            return true;
+        }
+        int64_t time = 0;
+        for (uint64_t i = 0; i < count; i++) {
+            int64_t delta;
+            if (!reader.GetSigned(delta)) return false;
+            time += delta;
+            columns.time.push_back(time);
+        }
+        bool ok = GetColumn(reader, count, columns.word) && GetColumn(reader, count, columns.length) &&
+                  GetColumn(reader, count, columns.guessed) && GetColumn(reader, count, columns.missed) &&
+                  GetColumn(reader, count, columns.misses) && GetColumn(reader, count, columns.guesses);
+        for (uint64_t i = 0; ok && i < count; i++) {
+            int64_t score = 0;
+            ok = reader.GetSigned(score);
+            columns.score.push_back(static_cast<int32_t>(score));
+        }
+        return ok && GetColumn(reader, count, columns.duration) && GetColumn(reader, count, columns.won);
+    }
+
+    // Drops the rows of a block that did not decode, so every column has the same length
+    static void TrimColumns(HistoryColumns& columns, size_t rows) {
+        columns.time.resize(rows);
+        columns.word.resize(rows);
+        columns.length.resize(rows);
+        columns.guessed.resize(rows);
+        columns.missed.resize(rows);
+        columns.misses.resize(rows);
+        columns.guesses.resize(rows);
+        columns.score.resize(rows);
+        columns.duration.resize(rows);
+        columns.won.resize(rows);
+    }
+
+public:
+    explicit HistoryArchive(string archive_file = "history.hga") : filename(move(archive_file)) {}
+    HistoryArchive(const HistoryArchive&) = delete;
+    HistoryArchive& operator=(const HistoryArchive&) = delete;
+    ~HistoryArchive() { Flush(); }
+
+    // Adds a finished round, whose word id is a rank in the dictionary with fingerprint
+    // dictionary_fingerprint; it is written with the next block
+    void Append(const RoundRecord& round, uint64_t dictionary_fingerprint) {
+        if (filename.empty()) return;
+        if (dictionary_fingerprint != dictionary) {
+            Flush(); // a block holds the rounds of one dictionary
+            dictionary = dictionary_fingerprint;
+        }
+        pending.push_back(round);
+        if (pending.size() >= BLOCK_ROWS) Flush();
+    }
+
+    // Writes the pending rounds as one block at the end of the archive
+    bool Flush() {
+        if (pending.empty()) return true;
+        ByteWriter block;
+        EncodeBlock(block);
+        FILE* file = fopen(filename.c_str(), "ab");
+        if (!file) return false;
+        bool ok = fwrite(block.data().data(), 1, block.data().size(), file) == block.data().size();
+        ok = fclose(file) == 0 && ok;
+        if (ok) pending.clear();
+        return ok;
+    }
+
+    // Writes the pending rounds to the current file and appends to archive_file from now on; "" for none
+    bool SetFile(string archive_file) {
+        bool ok = Flush();
+        filename = move(archive_file);
+        return ok;
+    }
+
+    const string& GetFile() const { return filename; }
+    size_t GetPending() const { return pending.size(); }
+
+    // The current time in the archive's unit
+    static int64_t Now() {
+        return chrono::duration_cast<chrono::seconds>(chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    // Loads every block of an archive played with the dictionary of fingerprint dictionary_fingerprint
+    // into columns, stopping at the first damaged one; returns false if the file cannot be read
+    static bool Load(const string& archive_file, uint64_t dictionary_fingerprint, HistoryColumns& columns) {
+        MappedFile file;
+        if (!file.Open(archive_file)) return false;
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(file.data());
+        size_t size = file.size(), pos = 0;
+        while (size - pos > 4 && memcmp(bytes + pos, "HGHB", 4) == 0) {
+            ByteReader header(bytes + pos + 4, size - pos - 4);
+            uint64_t body_size;
+            if (!header.GetVarint(body_size) || body_size + 4 > header.remaining()) break;
+            const uint8_t* body = bytes + size - header.remaining();
+            if (!CheckCrc(body, body_size + 4)) break;
+            size_t rows = columns.size();
+            if (!DecodeBlock(body, body_size, dictionary_fingerprint, columns)) {
+                TrimColumns(columns, rows);
+                break;
+            }
+            pos = body + body_size + 4 - bytes;
+        }
+        return true;
+    }
+
+    // Sums the rounds that pass a filter
+    static HistorySummary Query(const HistoryColumns& columns, const HistoryFilter& filter) {
+        const size_t n = columns.size();
+        vector<uint8_t> selected(n);
+
+        // filters: one pass per column, each a plain loop over an array
+        for (size_t i = 0; i < n; i++) selected[i] = columns.time[i] >= filter.since;
+        if (filter.length)
+            for (size_t i = 0; i < n; i++) selected[i] &= columns.length[i] == filter.length;
+        const uint64_t bit = filter.letter >= 0 ? uint64_t(1) << filter.letter : 0;
+        if (bit)
+            for (size_t i = 0; i < n; i++) selected[i] &= (columns.guessed[i] & bit) != 0;
+
+        // sums: every row is added, times 0 or 1
+        HistorySummary summary;
+        uint64_t rounds = 0, won = 0, misses = 0, guesses = 0, duration = 0, letter_missed = 0;
+        int64_t score = 0;
+        for (size_t i = 0; i < n; i++) {
+            const uint32_t s = selected[i];
+            rounds += s;
+            won += s & columns.won[i];
+            misses += s * columns.misses[i];
+            guesses += s * columns.guesses[i];
+            duration += s * columns.duration[i];
+            score += static_cast<int64_t>(s) * columns.score[i];
+        }
+        if (bit)
+            for (size_t i = 0; i < n; i++) letter_missed += selected[i] & ((columns.missed[i] & bit) != 0);
+        summary.rounds = rounds;
+        summary.won = won;
+        summary.misses = misses;
+        summary.guesses = guesses;
+        summary.duration = duration;
+        summary.score = score;
+        summary.letter_missed = letter_missed;
+        return summary;
+    }
+};
+
+#endif // HISTORY_ARCHIVE_HPP
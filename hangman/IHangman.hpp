@@ -1,74 +1,121 @@
-/*
-This is the abstract base class; It would be inherited by the Hangman class
-The class has member variables the hold the current game's state like the game's list of words,
-the current word to guess, number of guesse left, etc.
-*/
-
-#ifndef IHANGMAN_HPP
-#define IHANGMAN_HPP
-
-#include <string>
-#include <vector>
-#include "WordList.hpp"
-#include "HangmanScorer.hpp"
-using namespace std;
-class HangmanInterface;
-
-class IHangman {
-protected:
-    // Member variables
-    WordList wordlist; // list of words for the game
-    string word_to_guess; // the current word to guess
-    char guessed_letter; // the currently guessed letter
-    vector<char> guessed_word; // the correct guesses so far, for a given word
-    vector<char> incorrect_guesses; // the incorrect guesses made so far
-    int guesses_left; //  number of guesses left, for a given word
-    int guesses_used; // number of guesses used, for a given word
-    HangmanScorer hangman_scorer; // an object that holds methods for scoring
-    HangmanInterface* hangman_interface; // an object that provides the gaming interface
-    string profile_name; // the current player's name
-    int correct_words; // the number of correctly guesses words
-    bool is_game_loaded; // checks if game is loaded or is new
-
-public:
-    IHangman(const string& word_file) :
-        wordlist(word_file),
-        guesses_left(6),
-        guesses_used(0),
-        correct_words(0),
-        is_game_loaded(false) {}
-
-    virtual ~IHangman() = default;
-
-    // Pure virtual functions
-    virtual void CreateProfile(const std::string& name) = 0; // creates a user profile
-    virtual void LoadProfile(const std::string& name) = 0; // load a user profile if it exists or it creates a new one
-    virtual void SaveGame() = 0; // save the current game for the current user
-    virtual void LoadGame() = 0; // loads the current users previous game
-    virtual void PlayRound() = 0; // plays a single round of hangman
-
-    // Getters
-
-    virtual string GetWordToGuess() const { return word_to_guess; }
-    virtual vector<char> GetGuessedWord() const { return guessed_word; }
-    virtual vector<char> GetIncorrectGuesses() const { return incorrect_guesses; }
-    virtual char GetGuessedLetter() const { return guessed_letter; }
-    virtual int GetGuessesLeft() const { return guesses_left; }
-    virtual int GetScore() const { return hangman_scorer.GetScore(); }
-    virtual int GetCorrectWords() const { return correct_words; }
-    virtual bool IsGameLoaded() const { return is_game_loaded; }
-    virtual int GetGuessesUsed() const { return guesses_used; }
-
-    // Setters
-    virtual void SetProfileName(const std::string& name) { profile_name = name; }
-    virtual void SetWordToGuess(const std::string& word) { word_to_guess = word; }
-    virtual void SetGuessedWord(const std::vector<char>& word) { guessed_word = word; }
-    virtual void SetIncorrectGuesses(const std::vector<char>& guesses) { incorrect_guesses = guesses; }
-    virtual void SetGuessedLetter(char letter) { guessed_letter = letter; }
-    virtual void SetGuessesLeft(int guesses) { guesses_left = guesses; }
-    virtual void SetScore(int score) { hangman_scorer.SetScore(score); }
-    virtual void SetCorrectWords(int words) { correct_words = words; }
-    virtual void SetGameLoaded(bool loaded) { is_game_loaded = loaded; }
-    virtual void SetGuessesUsed(int guesses) { guesses_used = guesses; }
-};
-#endif // IHANGMAN_HPP
+/*
+This is the abstract base class; It would be inherited by the Hangman class
+The class has member variables the hold the current game's state like the game's list of words,
+the current word to guess, number of guesse left, etc.
+it takes the rules of the game (HangmanRules.hpp) as a template parameter; IHangman is the normal game
+the list of words loads in the background (see LazyWordList), so the welcome screen comes up
+at once; the time from construction to that first screen is kept as the startup time
+*/
+
+#ifndef IHANGMAN_HPP
+#define IHANGMAN_HPP
+
+#include <string>
+#include <string_view>
+#include <span>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include "LazyWordList.hpp"
+#include "HangmanScorer.hpp"
+#include "SessionIO.hpp"
+using namespace std;
+template <typename Rules> class BasicHangmanInterface;
+
+template <typename Rules>
+class BasicIHangman {
+protected:
+    // Member variables
+    chrono::steady_clock::time_point created = chrono::steady_clock::now(); // first, so it is set before the load starts
+    chrono::steady_clock::duration startup_time{}; // from construction to the first screen
+    LazyWordList wordlist; // list of words for the game, loaded in the background
+    string word_to_guess; // the current word to guess
+    char guessed_letter; // the currently guessed letter
+    vector<char> guessed_word; // the correct guesses so far, for a given word
+    vector<char> incorrect_guesses; // the incorrect guesses made so far
+    int guesses_left; //  number of guesses left, for a given word
+    int guesses_used; // number of guesses used, for a given word
+    BasicHangmanScorer<Rules> hangman_scorer; // an object that holds methods for scoring
+    BasicHangmanInterface<Rules>* hangman_interface; // an object that provides the gaming interface
+    string profile_name; // the current player's name
+    int correct_words; // the number of correctly guesses words
+    bool is_game_loaded; // checks if game is loaded or is new
+    bool is_evil; // evil mode: the word is not picked until it has to be
+    SessionIO io; // where the game reads its input and writes its output
+
+public:
+    BasicIHangman(const string& word_file, WordList::Mode word_mode = WordList::Mode::InMemory,
+                  WordList::Difficulty difficulty = WordList::Difficulty::Any) :
+        wordlist(word_file, word_mode, difficulty),
+        guesses_left(Rules::MAX_MISSES),
+        guesses_used(0),
+        correct_words(0),
+        is_game_loaded(false),
+        is_evil(false) {}
+
+    // Plays from a word list that is already loaded, shared with other games
+    explicit BasicIHangman(WordList& words) :
+        wordlist(words),
+        guesses_left(Rules::MAX_MISSES),
+        guesses_used(0),
+        correct_words(0),
+        is_game_loaded(false),
+        is_evil(false) {}
+
+    virtual ~BasicIHangman() = default;
+
+    // Pure virtual functions
+    // they wait for the player, so they are coroutines of the session, started with co_await
+    virtual Task CreateProfile(const std::string& name) = 0; // creates a user profile
+    virtual Task LoadProfile(const std::string& name) = 0; // load a user profile if it exists or it creates a new one
+    virtual Task SaveGame() = 0; // save the current game for the current user
+    virtual Task LoadGame() = 0; // loads the current users previous game
+    virtual Task PlayRound() = 0; // plays rounds of hangman, a word after each one won
+
+    // Getters
+    // they are not virtual and return views of the state, so calls inline and never copy;
+    // a view is valid until the state it shows is changed
+
+    string_view GetProfileName() const { return profile_name; }
+    string_view GetWordToGuess() const { return word_to_guess; }
+    span<const char> GetGuessedWord() const { return guessed_word; }
+    span<const char> GetIncorrectGuesses() const { return incorrect_guesses; }
+    char GetGuessedLetter() const { return guessed_letter; }
+    int GetGuessesLeft() const { return guesses_left; }
+    int GetScore() const { return hangman_scorer.GetScore(); }
+    int GetCorrectWords() const { return correct_words; }
+    bool IsGameLoaded() const { return is_game_loaded; }
+    bool IsEvil() const { return is_evil; }
+    int GetGuessesUsed() const { return guesses_used; }
+    SessionIO& GetIO() { return io; }
+    const SessionIO& GetIO() const { return io; }
+    chrono::steady_clock::duration GetStartupTime() const { return startup_time; }
+    chrono::steady_clock::duration GetLoadWait() const { return wordlist.GetWaited(); }
+
+    // Checks if every letter of the word has been revealed
+    bool IsWordGuessed() const {
+        return guessed_word.size() == word_to_guess.size() &&
+               equal(guessed_word.begin(), guessed_word.end(), word_to_guess.begin());
+    }
+
+    // Setters
+    void SetProfileName(string_view name) { profile_name = name; }
+    void SetWordToGuess(string_view word) { word_to_guess = word; }
+    void SetGuessedWord(span<const char> word) { guessed_word.assign(word.begin(), word.end()); }
+    void SetIncorrectGuesses(span<const char> guesses) { incorrect_guesses.assign(guesses.begin(), guesses.end()); }
+    void SetGuessedLetter(char letter) { guessed_letter = letter; }
+    void SetGuessesLeft(int guesses) { guesses_left = guesses; }
+    void SetScore(int score) { hangman_scorer.SetScore(score); }
+    void SetCorrectWords(int words) { correct_words = words; }
+    void SetGameLoaded(bool loaded) { is_game_loaded = loaded; }
+    void SetEvil(bool evil) { is_evil = evil; }
+    void SetGuessesUsed(int guesses) { guesses_used = guesses; }
+
+    // Called by the interface once its first screen is shown
+    void MarkFirstFrame() {
+        if (startup_time == chrono::steady_clock::duration::zero()) startup_time = chrono::steady_clock::now() - created;
+    }
+};
+
+using IHangman = BasicIHangman<EnglishRules>;
+#endif // IHANGMAN_HPP
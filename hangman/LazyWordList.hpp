@@ -0,0 +1,65 @@
+/*
+this class loads a WordList on a background thread, so the game can show its first screens
+while the dictionary is still being read
+the first use of the list waits for the load if it has not finished yet, and every use after
+that goes straight to the list; the time that first use spent waiting is kept, to show how
+much of the load the menus hid
+it is used from one thread, the game's; only the load itself runs on another
+a load that fails throws on its thread; the future carries the exception over, and the first
+use of the list throws it again on the game's thread
+it can also stand for a list that is already loaded and owned elsewhere, so many games share one
+*/
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <string>
+#include "WordList.hpp"
+#include "AllocTracker.hpp"
+using namespace std;
+
+#ifndef LAZY_WORDLIST_HPP
+#define LAZY_WORDLIST_HPP
+
+class LazyWordList {
+private:
+    future<unique_ptr<WordList>> loading; // the load, until it has been waited for
+    unique_ptr<WordList> loaded; // the list this loaded, null until the first use
+    WordList* list = nullptr; // the list in use, null until the first use of a list being loaded
+    chrono::steady_clock::duration waited{}; // how long the first use waited for the load
+
+public:
+    // Starts loading filename on its own thread
+    LazyWordList(const string& filename, WordList::Mode mode = WordList::Mode::InMemory,
+                 WordList::Difficulty difficulty = WordList::Difficulty::Any)
+        : loading(async(launch::async, [filename, mode, difficulty] {
+              AllocScope scope(AllocTag::Dictionary);
+              return make_unique<WordList>(filename, mode, difficulty);
+          })) {}
+
+    // Uses a list that is already loaded; it must outlive this
+    explicit LazyWordList(WordList& shared) : list(&shared) {}
+
+    LazyWordList(const LazyWordList&) = delete;
+    LazyWordList& operator=(const LazyWordList&) = delete;
+
+    // The list, waiting for the load the first time if it is still running; throws what the load threw
+    WordList& get() {
+        if (!list) {
+            auto start = chrono::steady_clock::now();
+            loaded = loading.get();
+            list = loaded.get();
+            waited = chrono::steady_clock::now() - start;
+        }
+        return *list;
+    }
+
+    WordList* operator->() { return &get(); }
+
+    // Checks if using the list now would not wait
+    bool IsReady() const { return list || loading.wait_for(chrono::seconds(0)) == future_status::ready; }
+
+    chrono::steady_clock::duration GetWaited() const { return waited; }
+};
+
+#endif // LAZY_WORDLIST_HPP
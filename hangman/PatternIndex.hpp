@@ -0,0 +1,147 @@
+/*
+this class answers pattern queries on a word list: which words fit a revealed pattern
+("_a__e_", '_' for hidden letters) and a set of letters known not to be in the word
+the words are grouped by length; for every group it keeps one bit per word for each
+(position, letter) pair, and one for each letter the word contains anywhere
+a query is then a few AND / AND NOT passes over 64 words at a time:
+  a revealed letter at a position: AND the bits for that (position, letter)
+  a hidden position: AND NOT the bits of every revealed letter there, since a guessed letter
+  is shown everywhere it appears
+  an excluded letter: AND NOT the bits of words that contain it
+the bits of a group are stored block by block (64 words), so one block's query reads one run of memory
+it takes the rules of the game (HangmanRules.hpp) for the alphabet; PatternIndex is the normal game's
+*/
+
+#include <bit>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "HangmanRules.hpp"
+#include "WordList.hpp"
+using namespace std;
+
+#ifndef PATTERN_INDEX_HPP
+#define PATTERN_INDEX_HPP
+
+template <typename Rules>
+class BasicPatternIndex {
+public:
+    using LetterMask = typename Rules::LetterMask;
+
+private:
+    static constexpr int LETTERS = Rules::ALPHABET_SIZE;
+
+    // The words of one length
+    struct Group {
+        vector<uint32_t> words; // the words of this length, by their index in the word list
+        size_t stride = 0; // bitset words per block: (length + 1) * LETTERS
+        vector<uint64_t> bits; // per block: a bit word per (position, letter), then one per letter contained
+    };
+
+    vector<Group> groups; // by word length
+
+    // Runs a query and calls visit(first, bits) for every block of 64 words, first being the block's first word
+    template <typename Visit>
+    void Scan(string_view pattern, LetterMask excluded, Visit visit) const {
+        size_t length = pattern.size();
+        if (length == 0 || length >= groups.size() || groups[length].words.empty()) return;
+        const Group& group = groups[length];
+
+        // the pattern as letter indices (-1 for hidden), and the letters it reveals
+        int letters[256];
+        LetterMask revealed = 0;
+        for (size_t p = 0; p < length; p++) {
+            letters[p] = pattern[p] == '_' ? -1 : Rules::LetterIndex(pattern[p]);
+            if (pattern[p] != '_' && letters[p] < 0) return; // not a letter, nothing fits
+            if (letters[p] >= 0) revealed |= LetterMask(1) << letters[p];
+        }
+        if (revealed & excluded) return; // a letter cannot be both in and out of the word
+
+        size_t count = group.words.size();
+        for (size_t first = 0; first < count; first += 64) {
+            const uint64_t* block = group.bits.data() + first / 64 * group.stride;
+            uint64_t bits = count - first >= 64 ? ~0ull : (1ull << (count - first)) - 1;
+            for (size_t p = 0; p < length && bits; p++) {
+                const uint64_t* at = block + p * LETTERS;
+                if (letters[p] >= 0) {
+                    bits &= at[letters[p]];
+                } else {
+                    for (LetterMask m = revealed; m; m &= m - 1) bits &= ~at[countr_zero(m)];
+                }
+            }
+            const uint64_t* has = block + length * LETTERS;
+            for (LetterMask m = excluded; m && bits; m &= m - 1) bits &= ~has[countr_zero(m)];
+            if (bits) visit(first, bits);
+        }
+    }
+
+public:
+    // Indexes every word of a word list
+    void Build(const WordList& wordlist) {
+        groups.clear();
+        wordlist.forEach([this](size_t i, string_view word) {
+            if (word.size() >= groups.size()) groups.resize(word.size() + 1);
+            groups[word.size()].words.push_back(static_cast<uint32_t>(i));
+        });
+
+        for (size_t length = 1; length < groups.size(); length++) {
+            Group& group = groups[length];
+            group.stride = (length + 1) * LETTERS;
+            group.bits.assign((group.words.size() + 63) / 64 * group.stride, 0);
+        }
+
+        // the words of each group are in list order, so a running count gives each word's slot
+        vector<size_t> next(groups.size(), 0);
+        wordlist.forEach([this, &next](size_t, string_view word) {
+            Group& group = groups[word.size()];
+            size_t slot = next[word.size()]++;
+            uint64_t* block = group.bits.data() + slot / 64 * group.stride;
+            uint64_t bit = 1ull << (slot % 64);
+            for (size_t p = 0; p < word.size(); p++) {
+                int letter = Rules::LetterIndex(word[p]);
+                if (letter < 0) continue;
+                block[p * LETTERS + letter] |= bit;
+                block[word.size() * LETTERS + letter] |= bit;
+            }
+        });
+    }
+
+    // Counts the words that fit a pattern ('_' for hidden letters) without any of the excluded letters
+    size_t Count(string_view pattern, LetterMask excluded = 0) const {
+        size_t total = 0;
+        Scan(pattern, excluded, [&total](size_t, uint64_t bits) { total += popcount(bits); });
+        return total;
+    }
+
+    // Returns the indices (in the word list) of the words that fit, in list order
+    vector<uint32_t> Match(string_view pattern, LetterMask excluded = 0) const {
+        vector<uint32_t> found;
+        if (pattern.size() >= groups.size()) return found;
+        const vector<uint32_t>& words = groups[pattern.size()].words;
+        Scan(pattern, excluded, [&](size_t first, uint64_t bits) {
+            for (; bits; bits &= bits - 1) found.push_back(words[first + countr_zero(bits)]);
+        });
+        return found;
+    }
+
+    // Turns a string of letters ("rst") into a letter mask; anything else is ignored
+    static LetterMask MaskOf(string_view letters) {
+        LetterMask mask = 0;
+        for (char c : letters)
+            if (Rules::LetterIndex(c) >= 0) mask |= LetterMask(1) << Rules::LetterIndex(c);
+        return mask;
+    }
+
+    // Bytes used by the index
+    size_t MemoryBytes() const {
+        size_t bytes = groups.capacity() * sizeof(Group);
+        for (const Group& group : groups)
+            bytes += group.words.capacity() * sizeof(uint32_t) + group.bits.capacity() * sizeof(uint64_t);
+        return bytes;
+    }
+};
+
+using PatternIndex = BasicPatternIndex<EnglishRules>;
+
+#endif // PATTERN_INDEX_HPP
@@ -0,0 +1,127 @@
+/*
+this class builds a minimal perfect hash over a fixed set of words (hash and displace)
+every word in the set maps to its own slot, so a lookup is two hashes and one array read;
+the caller still compares the candidate it gets back, since unknown words land on some slot too
+there is one bucket per KEYS_PER_BUCKET keys, and slot indices are bit packed,
+so the table costs about 1 byte per key plus log2(key count) bits per key
+*/
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include <algorithm>
+using namespace std;
+
+#ifndef PERFECT_HASH_HPP
+#define PERFECT_HASH_HPP
+
+class PerfectHash {
+private:
+    static constexpr size_t KEYS_PER_BUCKET = 4;
+
+    vector<int32_t> displacement; // per bucket: > 0 is the seed to rehash with, < 0 is -(slot + 1)
+    vector<uint64_t> slot_bits; // the index of the word stored in each slot, width bits each
+    size_t slot_count = 0; // number of slots, one per key
+    int width = 1; // bits per stored index
+
+    uint32_t SlotIndex(size_t slot) const {
+        size_t bit = slot * width;
+        uint64_t value = slot_bits[bit / 64] >> (bit % 64);
+        if (bit % 64 + width > 64) value |= slot_bits[bit / 64 + 1] << (64 - bit % 64);
+        return static_cast<uint32_t>(value & ((1ull << width) - 1));
+    }
+
+    void SetSlotIndex(size_t slot, uint32_t index) {
+        size_t bit = slot * width;
+        slot_bits[bit / 64] |= static_cast<uint64_t>(index) << (bit % 64);
+        if (bit % 64 + width > 64) slot_bits[bit / 64 + 1] |= static_cast<uint64_t>(index) >> (64 - bit % 64);
+    }
+
+    // Hashes a key with a seed (FNV-1a followed by a 64-bit finalizer)
+    static uint64_t Hash(string_view key, uint64_t seed) {
+        uint64_t h = 14695981039346656037ull ^ (seed * 0x9E3779B97F4A7C15ull);
+        for (char c : key) {
+            h ^= static_cast<unsigned char>(c);
+            h *= 1099511628211ull;
+        }
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdull;
+        h ^= h >> 33;
+        return h;
+    }
+
+public:
+    static constexpr uint32_t npos = 0xFFFFFFFFu;
+
+    // Builds the table; key_at(i) must return the i-th key as something convertible to string_view
+    template <typename KeyAt>
+    void Build(size_t count, KeyAt key_at) {
+        size_t bucket_count = (count + KEYS_PER_BUCKET - 1) / KEYS_PER_BUCKET;
+        slot_count = count;
+        width = 1;
+        while (width < 32 && (1ull << width) < count) width++;
+        displacement.assign(bucket_count, 0);
+        slot_bits.assign((count * width + 63) / 64 + 1, 0);
+        if (count == 0) return;
+
+        // first level: put every key in a bucket
+        vector<vector<uint32_t>> buckets(bucket_count);
+        for (size_t i = 0; i < count; i++)
+            buckets[Hash(key_at(i), 0) % bucket_count].push_back(static_cast<uint32_t>(i));
+
+        vector<uint32_t> order(bucket_count);
+        for (size_t b = 0; b < bucket_count; b++) order[b] = static_cast<uint32_t>(b);
+        sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+            return buckets[a].size() > buckets[b].size();
+        });
+
+        // second level: find a seed that places every key of a crowded bucket in a free slot
+        vector<bool> used(count, false);
+        vector<uint32_t> slots;
+        size_t pos = 0;
+        for (; pos < bucket_count && buckets[order[pos]].size() > 1; pos++) {
+            const vector<uint32_t>& bucket = buckets[order[pos]];
+            for (uint32_t seed = 1;; seed++) {
+                slots.clear();
+                bool fits = true;
+                for (uint32_t index : bucket) {
+                    uint32_t slot = static_cast<uint32_t>(Hash(key_at(index), seed) % count);
+                    if (used[slot] || find(slots.begin(), slots.end(), slot) != slots.end()) {
+                        fits = false;
+                        break;
+                    }
+                    slots.push_back(slot);
+                }
+                if (!fits) continue;
+                for (size_t k = 0; k < bucket.size(); k++) {
+                    used[slots[k]] = true;
+                    SetSlotIndex(slots[k], bucket[k]);
+                }
+                displacement[order[pos]] = static_cast<int32_t>(seed);
+                break;
+            }
+        }
+
+        // buckets with a single key go straight into the remaining free slots
+        uint32_t free_slot = 0;
+        for (; pos < bucket_count && buckets[order[pos]].size() == 1; pos++) {
+            while (used[free_slot]) free_slot++;
+            used[free_slot] = true;
+            SetSlotIndex(free_slot, buckets[order[pos]][0]);
+            displacement[order[pos]] = -static_cast<int32_t>(free_slot) - 1;
+        }
+    }
+
+    // Returns the only index the key could have, or npos for an empty table
+    uint32_t Find(string_view key) const {
+        if (slot_count == 0) return npos;
+        int32_t d = displacement[Hash(key, 0) % displacement.size()];
+        if (d < 0) return SlotIndex(-d - 1);
+        return SlotIndex(Hash(key, static_cast<uint64_t>(d)) % slot_count);
+    }
+
+    // Bytes used by the table
+    size_t MemoryBytes() const { return displacement.capacity() * sizeof(int32_t) + slot_bits.capacity() * sizeof(uint64_t); }
+};
+
+#endif // PERFECT_HASH_HPP
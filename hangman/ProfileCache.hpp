@@ -0,0 +1,223 @@
+/*
+this class keeps recently used profiles in memory, so the save files are read once and written rarely
+a profile is read from its file the first time it is asked for (the binary save, or an old
+text profile) and served from memory after that; a saved profile is only marked dirty, and
+dirty profiles are written together once the flush interval has passed, so a profile saved
+many times in between is written once
+an explicit save (Save) writes its profile at once instead, so it can say whether it worked
+a profile's statistics (see HangmanStats) are kept with it and written in the same batches, as
+<profile>.stats next to <profile>.sav
+the cache stays within a memory budget by dropping the least recently used profiles;
+a dirty profile is written before it is dropped, and stays if it cannot be written, so no
+change is lost; everything dirty is written on destruction
+a cache that is not persistent never reads or writes a file: it starts with no profiles and keeps
+everything in memory, for replays that must not depend on or change the saved games
+*/
+
+#include <chrono>
+#include <cstddef>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "BinaryFormat.hpp"
+#include "GameSnapshot.hpp"
+using namespace std;
+
+#ifndef PROFILE_CACHE_HPP
+#define PROFILE_CACHE_HPP
+
+class ProfileCache {
+private:
+    // A cached profile
+    struct Entry {
+        GameSnapshot snapshot; // the profile's saved game; its name is the key
+        vector<uint8_t> stats; // the profile's encoded statistics, empty if it has none
+        bool dirty = false; // the game changed since it was written
+        bool stats_dirty = false; // the statistics changed since they were written
+        size_t bytes = 0; // memory it uses, for the budget
+    };
+
+    list<Entry> entries; // most recently used first
+    unordered_map<string_view, list<Entry>::iterator> index; // keys point into the entries' names
+    size_t budget; // bytes the cache may use
+    size_t used = 0; // bytes the cache uses
+    chrono::steady_clock::duration interval; // how long dirty profiles wait to be written
+    chrono::steady_clock::time_point last_flush = chrono::steady_clock::now();
+    size_t writes = 0; // save files written
+    size_t reads = 0; // save files read
+    bool persistent = true; // profiles are read from and written to files
+
+public:
+    // What FlushIfDue did
+    enum class FlushResult { NotDue, Written, Failed };
+
+private:
+
+    static size_t Measure(const Entry& entry) {
+        const GameSnapshot& s = entry.snapshot;
+        return sizeof(Entry) + 64 + s.profile_name.capacity() + s.word_to_guess.capacity() +
+               s.guessed_word.capacity() + s.incorrect_guesses.capacity() + s.seen_words.capacity() +
+               entry.stats.capacity(); // 64: the list and map nodes
+    }
+
+    // Writes what changed of a profile, its game and its statistics; false if a file could not be
+    // written, and what was not written stays dirty
+    bool Write(Entry& entry) {
+        if (!persistent) {
+            entry.dirty = entry.stats_dirty = false;
+            return true;
+        }
+        bool ok = true;
+        if (entry.dirty) {
+            if (WriteWholeFile(entry.snapshot.profile_name + ".sav", entry.snapshot.Encode())) {
+                entry.dirty = false;
+                writes++;
+            } else {
+                ok = false;
+            }
+        }
+        if (entry.stats_dirty) {
+            if (WriteWholeFile(entry.snapshot.profile_name + ".stats", entry.stats)) {
+                entry.stats_dirty = false;
+                writes++;
+            } else {
+                ok = false;
+            }
+        }
+        return ok;
+    }
+
+    // Moves an entry to the front and updates its size
+    void Touch(list<Entry>::iterator entry) {
+        entries.splice(entries.begin(), entries, entry);
+        used -= entry->bytes;
+        entry->bytes = Measure(*entry);
+        used += entry->bytes;
+    }
+
+    // Drops the least recently used profiles until the cache fits, keeping the newest one; a dirty
+    // profile that cannot be written is kept (dirty) and the next older one is tried instead
+    void Trim() {
+        for (auto entry = entries.end(); used > budget && entry != entries.begin();) {
+            if (--entry == entries.begin()) break; // the newest stays
+            if (!Write(*entry)) continue;
+            used -= entry->bytes;
+            index.erase(entry->snapshot.profile_name);
+            entry = entries.erase(entry);
+        }
+    }
+
+    list<Entry>::iterator Insert(GameSnapshot&& snapshot, bool dirty) {
+        entries.emplace_front();
+        entries.front().snapshot = move(snapshot);
+        entries.front().dirty = dirty;
+        entries.front().bytes = 0;
+        index[entries.front().snapshot.profile_name] = entries.begin();
+        Touch(entries.begin());
+        return entries.begin();
+    }
+
+public:
+    ProfileCache(size_t budget_bytes = 1 << 20, chrono::milliseconds flush_interval = chrono::seconds(5))
+        : budget(budget_bytes), interval(flush_interval) {}
+    ProfileCache(const ProfileCache&) = delete;
+    ProfileCache& operator=(const ProfileCache&) = delete;
+    ~ProfileCache() { Flush(); }
+
+    // Returns a profile's saved game, reading it from disk the first time; nullptr if there is none
+    // the pointer is valid until the cache is changed
+    const GameSnapshot* Find(string_view name) {
+        auto found = index.find(name);
+        if (found != index.end()) {
+            Touch(found->second);
+            return &found->second->snapshot;
+        }
+
+        if (!persistent) return nullptr;
+        vector<uint8_t> bytes;
+        GameSnapshot snapshot;
+        string filename(name);
+        bool loaded = false;
+        if (ReadWholeFile(filename + ".sav", bytes)) {
+            loaded = snapshot.Decode(bytes);
+        } else if (ReadWholeFile(filename + ".txt", bytes)) {
+            loaded = snapshot.ImportText(bytes);
+        }
+        if (!loaded) return nullptr;
+        reads++;
+        snapshot.profile_name = filename; // the key is the name asked for
+        auto entry = Insert(move(snapshot), false);
+        if (ReadWholeFile(filename + ".stats", entry->stats)) reads++;
+        Touch(entry);
+        Trim();
+        return &entry->snapshot;
+    }
+
+    // Stores a profile's game; it is written at the next flush
+    void Put(const GameSnapshot& snapshot) {
+        auto found = index.find(snapshot.profile_name);
+        if (found != index.end()) {
+            auto entry = found->second;
+            index.erase(found); // the key points into the name that is replaced
+            entry->snapshot = snapshot;
+            entry->dirty = true;
+            index[entry->snapshot.profile_name] = entry;
+            Touch(entry);
+        } else {
+            Insert(GameSnapshot(snapshot), true);
+        }
+        Trim();
+    }
+
+    // Stores a profile's game and writes it now, with its statistics if they changed; returns false if
+    // it could not be written, in which case it stays dirty and is tried again at the next flush
+    bool Save(const GameSnapshot& snapshot) {
+        Put(snapshot);
+        return Write(*index.find(snapshot.profile_name)->second); // the newest, which Trim keeps
+    }
+
+    // A profile's encoded statistics, empty if it has none or is not a saved profile
+    const vector<uint8_t>& GetStats(string_view name) {
+        static const vector<uint8_t> none;
+        if (!Find(name)) return none;
+        return index.find(name)->second->stats;
+    }
+
+    // Stores a profile's encoded statistics; they are written with the next flush; false if there is
+    // no such profile
+    bool PutStats(string_view name, vector<uint8_t> stats) {
+        if (!Find(name)) return false; // brings the profile back if it was dropped
+        auto entry = index.find(name)->second;
+        entry->stats = move(stats);
+        entry->stats_dirty = true;
+        Touch(entry);
+        Trim();
+        return true;
+    }
+
+    // Writes every dirty profile; returns false if any could not be written (they stay dirty)
+    bool Flush() {
+        bool ok = true;
+        for (Entry& entry : entries) ok = Write(entry) && ok;
+        last_flush = chrono::steady_clock::now();
+        return ok;
+    }
+
+    // Flushes if the interval has passed since the last flush
+    FlushResult FlushIfDue() {
+        if (chrono::steady_clock::now() - last_flush < interval) return FlushResult::NotDue;
+        return Flush() ? FlushResult::Written : FlushResult::Failed;
+    }
+
+    // Turns reading and writing files on or off; profiles already cached stay
+    void SetPersistent(bool on) { persistent = on; }
+
+    size_t size() const { return entries.size(); }
+    size_t MemoryBytes() const { return used; }
+    size_t GetWrites() const { return writes; }
+    size_t GetReads() const { return reads; }
+};
+
+#endif // PROFILE_CACHE_HPP
@@ -0,0 +1,128 @@
+/*
+this class remembers which words of the dictionary a profile has already been given, one bit
+per word (by its rank), so a player does not get the same word again until every word has come up
+a draw takes words from the list's own draws (so by their weights) and redraws the ones already
+given, which keeps the weights exact; only when the bitmap is so full that a bounded number of
+draws all hit given words does it walk the unseen words, skipping full 64 bit blocks at once, and
+pick one of them by weight
+words of weight 0 are never given; once every other word has been, the bitmap starts over
+the bits are word ranks of one dictionary, so the bitmap keeps that dictionary's fingerprint
+(see WordList::fingerprint) and is started over when the words are drawn from another one, even
+one of the same size
+saved with the profile as its word count, the bitmap bytes (375 bytes for 2,999 words) and the
+fingerprint
+*/
+
+#include <bit>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+using namespace std;
+
+#ifndef SEEN_WORDS_HPP
+#define SEEN_WORDS_HPP
+
+class SeenWords {
+private:
+    static constexpr int MAX_DRAWS = 64; // draws before an unseen word is picked directly
+
+    vector<uint64_t> bits; // bit i set: word i was given
+    size_t total = 0; // words in the dictionary
+    size_t seen = 0; // bits set
+    uint64_t dictionary = 0; // fingerprint of the dictionary the bits are ranks in
+
+    // Calls visit(i) for every unseen word in order, until it returns false
+    template <typename Visit>
+    void ForEachUnseen(Visit visit) const {
+        for (size_t block = 0; block < bits.size(); block++) {
+            uint64_t unseen = ~bits[block];
+            if (block == bits.size() - 1 && total % 64) unseen &= (uint64_t(1) << (total % 64)) - 1;
+            for (; unseen; unseen &= unseen - 1) // drops the lowest set bit
+                if (!visit(block * 64 + static_cast<size_t>(countr_zero(unseen)))) return;
+        }
+    }
+
+    // Picks an unseen word with a chance proportional to weight(i); total if none has a weight above 0
+    template <typename Weight>
+    size_t PickUnseen(mt19937& rng, Weight weight) const {
+        double sum = 0;
+        ForEachUnseen([&](size_t i) {
+            sum += weight(i);
+            return true;
+        });
+        if (!(sum > 0)) return total;
+        double target = uniform_real_distribution<double>(0, sum)(rng);
+        size_t picked = total;
+        ForEachUnseen([&](size_t i) {
+            double w = weight(i);
+            if (w > 0) picked = i; // the last word of weight above 0, in case rounding runs past the end
+            target -= w;
+            return !(w > 0 && target < 0);
+        });
+        return picked;
+    }
+
+public:
+    // Forgets every word, for a dictionary of word_count words with fingerprint dictionary_fingerprint
+    void Reset(size_t word_count, uint64_t dictionary_fingerprint) {
+        dictionary = dictionary_fingerprint;
+        total = word_count;
+        seen = 0;
+        bits.assign((word_count + 63) / 64, 0);
+    }
+
+    bool IsSeen(size_t i) const { return i < total && (bits[i / 64] >> (i % 64) & 1); }
+
+    void Mark(size_t i) {
+        if (i >= total || IsSeen(i)) return;
+        bits[i / 64] |= uint64_t(1) << (i % 64);
+        seen++;
+    }
+
+    // Draws a word not given yet and marks it; pick(rng) draws any word by its weight, and weight(i)
+    // is that weight; the dictionary size must match the one of Reset
+    template <typename Pick, typename Weight>
+    size_t Draw(mt19937& rng, Pick pick, Weight weight) {
+        for (int draw = 0; draw < MAX_DRAWS; draw++) {
+            size_t i = pick(rng);
+            if (!IsSeen(i)) {
+                Mark(i);
+                return i;
+            }
+        }
+        size_t i = PickUnseen(rng, weight);
+        if (i == total) { // every word that can be drawn has been given
+            Reset(total, dictionary);
+            i = pick(rng);
+        }
+        Mark(i);
+        return i;
+    }
+
+    size_t size() const { return total; }
+    uint64_t GetDictionary() const { return dictionary; }
+    size_t GetSeen() const { return seen; }
+
+    // The bitmap as bytes, lowest word first, for the save file
+    string Save() const {
+        string bytes((total + 7) / 8, '\0');
+        for (size_t i = 0; i < bytes.size(); i++) bytes[i] = static_cast<char>(bits[i / 8] >> (8 * (i % 8)));
+        return bytes;
+    }
+
+    // Restores a saved bitmap; one whose size does not fit word_count is dropped and the bitmap starts
+    // over; the fingerprint is checked when words are drawn (see WordList::getRandomWord)
+    void Load(size_t word_count, uint64_t dictionary_fingerprint, string_view bytes) {
+        Reset(word_count, dictionary_fingerprint);
+        if (bytes.size() != (word_count + 7) / 8) return;
+        for (size_t i = 0; i < bytes.size(); i++)
+            bits[i / 8] |= static_cast<uint64_t>(static_cast<uint8_t>(bytes[i])) << (8 * (i % 8));
+        if (word_count % 64) bits.back() &= (uint64_t(1) << (word_count % 64)) - 1;
+        seen = 0;
+        for (uint64_t block : bits) seen += static_cast<size_t>(popcount(block));
+    }
+};
+
+#endif // SEEN_WORDS_HPP
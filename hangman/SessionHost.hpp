@@ -0,0 +1,198 @@
+/*
+this class holds every live game of a host that serves many players at once, and checkpoints them
+a checkpoint forks the process: the child sees a copy-on-write image of every session as it
+was at the fork, writes them all into one snapshot file and exits, while the parent carries on
+serving; the parent only pays for the fork and for the pages it changes while the child runs
+the child writes to <file>.tmp and renames it, so the snapshot file is always a complete one
+a restart maps the snapshot and restores every session in one pass
+on Windows there is no fork, so the snapshot is written before Checkpoint returns
+
+snapshot layout: "HGCK", varint version, varint slot count (ids in use, live or closed), then
+per slot, in id order: a live byte, and for a live one the profile name and the round (see
+HangmanRound); then a CRC-32 of all the bytes before it
+a session's id is its slot, so a restore never makes more slots than the snapshot has bytes
+*/
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+#ifndef _WIN32
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+#include "BinaryFormat.hpp"
+#include "HangmanRound.hpp"
+#include "MappedFile.hpp"
+using namespace std;
+
+#ifndef SESSION_HOST_HPP
+#define SESSION_HOST_HPP
+
+template <typename Rules>
+class BasicSessionHost {
+public:
+    static constexpr uint64_t VERSION = 2;
+    enum class CheckpointState { Idle, Running, Succeeded, Failed };
+
+    // One player's game
+    struct Session {
+        bool live = false;
+        string profile; // the player's name
+        BasicHangmanRound<Rules> round; // the current word
+    };
+
+private:
+    vector<Session> sessions; // by id
+    vector<uint32_t> free_ids; // ids of closed sessions, reused first
+    size_t live_count = 0;
+#ifndef _WIN32
+    pid_t child = -1; // the process writing the checkpoint, -1 if none
+#endif
+    CheckpointState last = CheckpointState::Idle; // how the last checkpoint ended
+
+    // Writes every live session to filename, through a temporary file
+    bool WriteSnapshot(const string& filename) const {
+        ByteWriter writer;
+        writer.PutRaw("HGCK", 4);
+        writer.PutVarint(VERSION);
+        writer.PutVarint(sessions.size());
+        for (const Session& session : sessions) {
+            writer.PutRaw(session.live ? "\1" : "\0", 1);
+            if (!session.live) continue;
+            writer.PutString(session.profile);
+            session.round.Encode(writer);
+        }
+        writer.PutCrc();
+        string temporary = filename + ".tmp";
+        if (!WriteWholeFile(temporary, writer.data())) return false;
+        remove(filename.c_str()); // rename does not replace a file on Windows
+        return rename(temporary.c_str(), filename.c_str()) == 0;
+    }
+
+public:
+    BasicSessionHost() = default;
+    BasicSessionHost(const BasicSessionHost&) = delete;
+    BasicSessionHost& operator=(const BasicSessionHost&) = delete;
+    ~BasicSessionHost() { WaitForCheckpoint(); }
+
+    // Starts a session for a player on a word, returns its id
+    uint32_t Open(string_view profile, string_view word) {
+        uint32_t id;
+        if (!free_ids.empty()) {
+            id = free_ids.back();
+            free_ids.pop_back();
+        } else {
+            id = static_cast<uint32_t>(sessions.size());
+            sessions.emplace_back();
+        }
+        Session& session = sessions[id];
+        session.live = true;
+        session.profile.assign(profile);
+        session.round.Start(word);
+        live_count++;
+        return id;
+    }
+
+    // Ends a session; its id can be given to a new one
+    void Close(uint32_t id) {
+        if (id >= sessions.size() || !sessions[id].live) return;
+        sessions[id].live = false;
+        free_ids.push_back(id);
+        live_count--;
+    }
+
+    bool IsLive(uint32_t id) const { return id < sessions.size() && sessions[id].live; }
+    Session& Get(uint32_t id) { return sessions[id]; }
+    const Session& Get(uint32_t id) const { return sessions[id]; }
+    size_t size() const { return live_count; }
+
+    // Calls visit(id, session) for every live session
+    template <typename Visit>
+    void ForEach(Visit visit) const {
+        for (size_t id = 0; id < sessions.size(); id++)
+            if (sessions[id].live) visit(static_cast<uint32_t>(id), sessions[id]);
+    }
+
+    // Starts writing every live session to filename; returns false if a checkpoint is still running
+    // or the fork failed; on Windows the snapshot is written before it returns
+    bool Checkpoint(const string& filename) {
+#ifdef _WIN32
+        last = WriteSnapshot(filename) ? CheckpointState::Succeeded : CheckpointState::Failed;
+        return last == CheckpointState::Succeeded;
+#else
+        if (PollCheckpoint() == CheckpointState::Running) return false;
+        fflush(nullptr); // buffered output would otherwise be written by both processes
+        pid_t pid = fork();
+        if (pid < 0) return false;
+        if (pid == 0) _exit(WriteSnapshot(filename) ? 0 : 1);
+        child = pid;
+        last = CheckpointState::Running;
+        return true;
+#endif
+    }
+
+    // Checks on the last checkpoint without waiting
+    CheckpointState PollCheckpoint() {
+#ifndef _WIN32
+        int status;
+        if (child > 0 && waitpid(child, &status, WNOHANG) == child) {
+            child = -1;
+            last = WIFEXITED(status) && WEXITSTATUS(status) == 0 ? CheckpointState::Succeeded : CheckpointState::Failed;
+        }
+#endif
+        return last;
+    }
+
+    // Waits for the last checkpoint to be written
+    CheckpointState WaitForCheckpoint() {
+#ifndef _WIN32
+        int status;
+        if (child > 0 && waitpid(child, &status, 0) == child)
+            last = WIFEXITED(status) && WEXITSTATUS(status) == 0 ? CheckpointState::Succeeded : CheckpointState::Failed;
+        child = -1;
+#endif
+        return last;
+    }
+
+    // Replaces every session with the ones of a snapshot; returns false (and keeps the sessions)
+    // if the file is missing or damaged
+    bool Restore(const string& filename) {
+        MappedFile file;
+        if (!file.Open(filename)) return false;
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(file.data());
+        if (file.size() < 8 || memcmp(bytes, "HGCK", 4) != 0 || !CheckCrc(bytes, file.size())) return false;
+
+        ByteReader reader(bytes + 4, file.size() - 8);
+        uint64_t version, slots;
+        if (!reader.GetVarint(version) || version != VERSION || !reader.GetVarint(slots)) return false;
+        if (slots > reader.remaining() || slots > UINT32_MAX) return false; // every slot takes a byte at least
+        vector<Session> restored(slots);
+        size_t count = 0;
+        for (Session& session : restored) {
+            uint8_t live;
+            if (!reader.GetRaw(&live, 1) || live > 1) return false;
+            if (!live) continue;
+            string_view profile;
+            if (!reader.GetString(profile) || !session.round.Decode(reader)) return false;
+            session.live = true;
+            session.profile.assign(profile);
+            count++;
+        }
+        if (reader.remaining() != 0) return false;
+
+        sessions.swap(restored);
+        free_ids.clear();
+        for (size_t id = sessions.size(); id-- > 0;)
+            if (!sessions[id].live) free_ids.push_back(static_cast<uint32_t>(id));
+        live_count = count;
+        return true;
+    }
+};
+
+using SessionHost = BasicSessionHost<EnglishRules>;
+
+#endif // SESSION_HOST_HPP
@@ -0,0 +1,149 @@
+/*
+this class is where a game session reads its input and writes its output
+a session runs as a coroutine on a SessionScheduler (see Hangman::Start), so reading an input
+is co_await io.ReadToken(token): the session suspends until the host delivers the input, and
+pauses are timers of the scheduler, not sleeps
+by default the host is the console: PlayGame pulls each input from cin, a line when the
+session waits for Enter and a word otherwise; a session can also be recorded (the word list
+seed plus every input read, one per line) and replayed later from that file, headless:
+nothing is drawn and there are no delays, so a replay runs as fast as the machine can go, and
+the game keeps its profiles in memory (see Hangman::ReplaySession)
+session file: "hangman-session 1", "seed <n>", then the inputs
+*/
+
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "SessionScheduler.hpp"
+using namespace std;
+
+#ifndef SESSION_IO_HPP
+#define SESSION_IO_HPP
+
+class SessionIO {
+private:
+    istream* in = &cin; // where the console host pulls inputs from
+    ostream* out = &cout; // where the game draws itself
+    ostream null_out{nullptr}; // swallows all output when replaying
+    ifstream replay_file; // the session being replayed
+    ofstream record_file; // the session being recorded
+    bool headless = false; // skips drawing, clearing and delays
+    SessionScheduler* scheduler = nullptr; // runs the session
+    uint32_t id = 0; // the session's id in the scheduler
+    bool wants_line = false; // the session waits for Enter, not for a word
+    bool ended = false; // the input has run out
+    string line; // what was entered while the session waited for Enter
+    string number; // the text of a number being read
+    size_t inputs = 0; // number of inputs read so far
+
+    // Copies an input to the recording
+    void Record(const string& input) {
+        inputs++;
+        if (record_file.is_open()) record_file << input << "\n";
+    }
+
+public:
+    // Waits for the session's next input; resumes with false once the input has run out
+    struct InputAwaiter {
+        enum class Kind { Token, Number, Enter };
+
+        SessionIO& io;
+        Kind kind;
+        int* value; // where a number goes
+        SessionScheduler::InputAwaiter next;
+
+        bool await_ready() { return next.await_ready(); }
+        void await_suspend(coroutine_handle<> session) { next.await_suspend(session); }
+        bool await_resume() {
+            io.wants_line = false;
+            if (!next.await_resume()) {
+                io.ended = true;
+                return false;
+            }
+            if (kind == Kind::Enter) {
+                io.Record("");
+            } else {
+                io.Record(next.input);
+            }
+            // anything that is not a number reads as 0
+            if (kind == Kind::Number && from_chars(io.number.data(), io.number.data() + io.number.size(), *value).ec != errc())
+                *value = 0;
+            return true;
+        }
+    };
+
+    // Connects the session to the scheduler that runs it, as session id
+    void Attach(SessionScheduler& session_scheduler, uint32_t session_id) {
+        scheduler = &session_scheduler;
+        id = session_id;
+    }
+
+    // Starts writing every input to filename, after the seed the word list uses
+    bool StartRecording(const string& filename, uint32_t seed) {
+        record_file.open(filename);
+        if (!record_file.is_open()) return false;
+        record_file << "hangman-session 1\nseed " << seed << "\n";
+        return true;
+    }
+
+    // Replays a recorded session headless, seed is set to the recorded seed
+    bool StartReplay(const string& filename, uint32_t& seed) {
+        replay_file.open(filename);
+        string magic, seed_label;
+        int version;
+        if (!(replay_file >> magic >> version >> seed_label >> seed) ||
+            magic != "hangman-session" || version != 1 || seed_label != "seed")
+            return false;
+        replay_file.ignore(); // the end of the seed line
+        in = &replay_file;
+        out = &null_out;
+        headless = true;
+        return true;
+    }
+
+    // Runs the session without the console, for a host that delivers its inputs itself: the game
+    // draws itself to output, and nothing is cleared and nothing pauses
+    void StartHeadless(ostream& output) {
+        out = &output;
+        headless = true;
+    }
+
+    ostream& Out() { return *out; }
+    bool IsHeadless() const { return headless; }
+    bool HasEnded() const { return ended; }
+    size_t InputCount() const { return inputs; }
+
+    // Reads one word
+    InputAwaiter ReadToken(string& token) {
+        return InputAwaiter{*this, InputAwaiter::Kind::Token, nullptr, scheduler->NextInput(id, token)};
+    }
+
+    // Reads a number
+    InputAwaiter ReadInt(int& value) {
+        return InputAwaiter{*this, InputAwaiter::Kind::Number, &value, scheduler->NextInput(id, number)};
+    }
+
+    // Waits for the player to press Enter
+    InputAwaiter WaitForEnter() {
+        wants_line = true;
+        return InputAwaiter{*this, InputAwaiter::Kind::Enter, nullptr, scheduler->NextInput(id, line)};
+    }
+
+    // Pauses the session; no pause at all when headless
+    SessionScheduler::SleepAwaiter Delay(chrono::milliseconds delay) {
+        return scheduler->Sleep(id, headless ? chrono::milliseconds(0) : delay);
+    }
+
+    // Reads what the session waits for from the console or the replayed file, for the console
+    // host: the rest of the line when it waits for Enter, the next word otherwise; false once
+    // there is no more
+    bool Pull(string& input) {
+        if (wants_line) return static_cast<bool>(getline(*in, input));
+        return static_cast<bool>(*in >> input);
+    }
+};
+
+#endif // SESSION_IO_HPP
@@ -0,0 +1,284 @@
+/*
+this class runs many game sessions on one thread, as C++20 coroutines
+a session is written as straight line code, and suspends where a blocking game would wait:
+  co_await scheduler.NextInput(id, input) until the player's next input arrives
+  co_await scheduler.Sleep(id, delay) for a pause, instead of sleeping the thread
+while suspended a session is only its coroutine frame and a slot here; the host hands inputs
+to Deliver as they come in and calls Run to resume every session that can go on
+a finished session's slot is emptied and its id reused by the next Spawn, the way SessionHost
+reuses ids, so the slots grow with the sessions live at once, not with every session ever run
+a session can co_await parts of itself written as coroutines too (Task), which start when
+awaited and hand control straight back when they end; an exception a session does not catch
+ends it and is thrown again from Run
+the allocation tag of a suspended session (see AllocTracker) is put back when it resumes, so
+scopes inside a session count its allocations and nothing the host does in between
+*/
+
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+#include "AllocTracker.hpp"
+using namespace std;
+
+#ifndef SESSION_SCHEDULER_HPP
+#define SESSION_SCHEDULER_HPP
+
+// The coroutine type of a session; it starts suspended and is owned by the scheduler once spawned
+class SessionTask {
+public:
+    struct promise_type {
+        exception_ptr error; // what ended the session, if it did not return
+
+        SessionTask get_return_object() { return SessionTask(coroutine_handle<promise_type>::from_promise(*this)); }
+        suspend_always initial_suspend() noexcept { return {}; }
+        suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { error = current_exception(); }
+    };
+
+private:
+    coroutine_handle<promise_type> handle;
+
+public:
+    explicit SessionTask(coroutine_handle<promise_type> h) : handle(h) {}
+    SessionTask(SessionTask&& other) noexcept : handle(exchange(other.handle, nullptr)) {}
+    SessionTask(const SessionTask&) = delete;
+    SessionTask& operator=(const SessionTask&) = delete;
+    ~SessionTask() { if (handle) handle.destroy(); }
+
+    // Gives up ownership of the coroutine
+    coroutine_handle<promise_type> Release() { return exchange(handle, nullptr); }
+};
+
+// A part of a session written as a coroutine, like a menu; it starts when it is co_awaited and
+// resumes the awaiting coroutine when it ends, rethrowing its exception there
+class Task {
+public:
+    struct promise_type {
+        coroutine_handle<> continuation; // the coroutine awaiting this one
+        exception_ptr error;
+
+        // Resumes the awaiting coroutine once this one ends
+        struct FinalAwaiter {
+            bool await_ready() const noexcept { return false; }
+            coroutine_handle<> await_suspend(coroutine_handle<promise_type> h) noexcept { return h.promise().continuation; }
+            void await_resume() const noexcept {}
+        };
+
+        Task get_return_object() { return Task(coroutine_handle<promise_type>::from_promise(*this)); }
+        suspend_always initial_suspend() noexcept { return {}; }
+        FinalAwaiter final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { error = current_exception(); }
+    };
+
+private:
+    coroutine_handle<promise_type> handle;
+
+public:
+    explicit Task(coroutine_handle<promise_type> h) : handle(h) {}
+    Task(Task&& other) noexcept : handle(exchange(other.handle, nullptr)) {}
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    ~Task() { if (handle) handle.destroy(); }
+
+    bool await_ready() const noexcept { return false; }
+    coroutine_handle<> await_suspend(coroutine_handle<> awaiting) noexcept {
+        handle.promise().continuation = awaiting;
+        return handle; // runs this one on the same thread, without growing the stack
+    }
+    void await_resume() const {
+        if (handle.promise().error) rethrow_exception(handle.promise().error);
+    }
+};
+
+class SessionScheduler {
+public:
+    using Clock = chrono::steady_clock;
+    struct InputAwaiter;
+
+private:
+    // One session
+    struct Slot {
+        coroutine_handle<SessionTask::promise_type> coroutine; // the session, null once it has finished
+        coroutine_handle<> suspended; // the coroutine of the session that waits, maybe a Task inside it
+        InputAwaiter* waiting = nullptr; // set while the session waits for an input
+        vector<string> inputs; // inputs delivered and not read yet
+        size_t next_input = 0; // the first of inputs not read yet
+        bool closed = false; // no more inputs will come
+    };
+
+    struct Timer {
+        Clock::time_point deadline;
+        uint32_t id;
+        bool operator>(const Timer& other) const { return deadline > other.deadline; }
+    };
+
+    vector<Slot> slots; // by session id
+    vector<uint32_t> ready; // sessions to resume
+    vector<uint32_t> resuming; // the ones being resumed now
+    priority_queue<Timer, vector<Timer>, greater<Timer>> timers; // sleeping sessions
+    vector<uint32_t> free_ids; // ids of finished sessions, reused first
+    size_t live = 0; // sessions not finished
+
+    // Ends a finished session: destroys its coroutine, frees its inputs and makes its id free
+    void Finish(uint32_t id) {
+        slots[id].coroutine.destroy();
+        slots[id] = Slot(); // drops the inputs' storage too
+        free_ids.push_back(id);
+        live--;
+    }
+
+    // Gives a session waiting with awaiter its next input; false if there is none yet
+    static bool Feed(Slot& slot, InputAwaiter& awaiter) {
+        if (slot.next_input < slot.inputs.size()) {
+            awaiter.input = move(slot.inputs[slot.next_input++]);
+            if (slot.next_input == slot.inputs.size()) {
+                slot.inputs.clear();
+                slot.next_input = 0;
+            }
+            awaiter.received = true;
+            return true;
+        }
+        awaiter.received = false;
+        return slot.closed;
+    }
+
+public:
+    // Waits for a session's next input; resumes with false once its input is closed
+    struct InputAwaiter {
+        SessionScheduler& scheduler;
+        uint32_t id;
+        string& input;
+        bool received = false;
+        AllocTag tag = AllocTag::Other; // the session's allocation tag while it waits
+
+        bool await_ready() { return Feed(scheduler.slots[id], *this); }
+        void await_suspend(coroutine_handle<> waiting) {
+            tag = AllocTracker::Current();
+            scheduler.slots[id].suspended = waiting;
+            scheduler.slots[id].waiting = this;
+        }
+        bool await_resume() {
+            AllocTracker::Swap(tag);
+            return received;
+        }
+    };
+
+    // Suspends a session for a while
+    struct SleepAwaiter {
+        SessionScheduler& scheduler;
+        uint32_t id;
+        Clock::duration delay;
+        AllocTag tag = AllocTag::Other; // the session's allocation tag while it sleeps
+
+        bool await_ready() const { return delay <= Clock::duration::zero(); }
+        void await_suspend(coroutine_handle<> sleeping) {
+            tag = AllocTracker::Current();
+            scheduler.slots[id].suspended = sleeping;
+            scheduler.timers.push(Timer{Clock::now() + delay, id});
+        }
+        void await_resume() { AllocTracker::Swap(tag); }
+    };
+
+    SessionScheduler() = default;
+    SessionScheduler(const SessionScheduler&) = delete;
+    SessionScheduler& operator=(const SessionScheduler&) = delete;
+    ~SessionScheduler() {
+        for (Slot& slot : slots)
+            if (slot.coroutine) slot.coroutine.destroy();
+    }
+
+    // The id the next Spawn gives, so the coroutine can be made with it; a finished session's id first
+    uint32_t NextId() const { return free_ids.empty() ? static_cast<uint32_t>(slots.size()) : free_ids.back(); }
+
+    // Takes a session made with NextId() and runs it at the next Run
+    uint32_t Spawn(SessionTask task) {
+        uint32_t id = NextId();
+        if (free_ids.empty()) {
+            slots.emplace_back();
+        } else {
+            free_ids.pop_back();
+        }
+        slots[id].coroutine = task.Release();
+        slots[id].suspended = slots[id].coroutine;
+        ready.push_back(id);
+        live++;
+        return id;
+    }
+
+    InputAwaiter NextInput(uint32_t id, string& input) { return InputAwaiter{*this, id, input}; }
+
+    SleepAwaiter Sleep(uint32_t id, Clock::duration delay) { return SleepAwaiter{*this, id, delay}; }
+
+    // Hands an input to a session; it goes on at the next Run if it was waiting for one
+    void Deliver(uint32_t id, string input) {
+        if (id >= slots.size() || !slots[id].coroutine || slots[id].closed) return;
+        Slot& slot = slots[id];
+        slot.inputs.push_back(move(input));
+        if (slot.waiting && Feed(slot, *slot.waiting)) {
+            slot.waiting = nullptr;
+            ready.push_back(id);
+        }
+    }
+
+    // Tells a session no more input will come; it sees its input end at the next Run
+    void Close(uint32_t id) {
+        if (id >= slots.size() || !slots[id].coroutine || slots[id].closed) return;
+        Slot& slot = slots[id];
+        slot.closed = true;
+        if (slot.waiting && Feed(slot, *slot.waiting)) {
+            slot.waiting = nullptr;
+            ready.push_back(id);
+        }
+    }
+
+    // Resumes every session whose input arrived or whose sleep is over; returns how many ran
+    // rethrows what a session threw, once that session has been removed
+    size_t Run(Clock::time_point now = Clock::now()) {
+        while (!timers.empty() && timers.top().deadline <= now) {
+            ready.push_back(timers.top().id);
+            timers.pop();
+        }
+        size_t ran = 0;
+        while (!ready.empty()) {
+            resuming.swap(ready);
+            for (size_t i = 0; i < resuming.size(); i++) {
+                const uint32_t id = resuming[i];
+                Slot& slot = slots[id];
+                if (!slot.coroutine) continue;
+                const AllocTag host_tag = AllocTracker::Current();
+                slot.suspended.resume();
+                AllocTracker::Swap(host_tag); // the session's tag stays with the session
+                ran++;
+                if (slots[id].coroutine.done()) {
+                    exception_ptr error = slots[id].coroutine.promise().error;
+                    Finish(id);
+                    if (error) {
+                        ready.insert(ready.end(), resuming.begin() + i + 1, resuming.end()); // they run next time
+                        resuming.clear();
+                        rethrow_exception(error);
+                    }
+                }
+            }
+            resuming.clear();
+        }
+        return ran;
+    }
+
+    // When the next sleeping session wakes up, or Clock::time_point::max() if none sleeps
+    Clock::time_point NextWakeUp() const { return timers.empty() ? Clock::time_point::max() : timers.top().deadline; }
+
+    // Checks if a session is suspended waiting for an input
+    bool IsWaiting(uint32_t id) const { return id < slots.size() && slots[id].waiting != nullptr; }
+
+    size_t size() const { return live; }
+    size_t SlotCount() const { return slots.size(); }
+};
+
+#endif // SESSION_SCHEDULER_HPP
@@ -0,0 +1,228 @@
+/*
+a local transport between the game engine and a bot in another process, through shared memory
+the engine creates a named segment holding two SpscRings: requests from the bot and replies
+from the engine; a round trip is one push and one pop each way, with no system call unless
+a side goes to sleep in futex mode
+one segment serves one bot playing one game at a time; a bot starts a game with a seed (the
+word is the one drawn after seeding the word list, like a recorded session) and then guesses letters
+segment layout: "HGSHM\0\0\0", uint32 ready, uint32 version, uint32 wait mode, then the two rings
+*/
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <thread>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#include "SpscRing.hpp"
+#include "HangmanRound.hpp"
+#include "WordList.hpp"
+using namespace std;
+
+#ifndef SHARED_MEMORY_TRANSPORT_HPP
+#define SHARED_MEMORY_TRANSPORT_HPP
+
+// A message from the bot
+struct ShmRequest {
+    enum Type : uint32_t { NewGame, Guess, Quit };
+    uint32_t type;
+    uint32_t seed; // NewGame: the word list seed
+    char letter; // Guess: the letter
+    char unused[7];
+};
+
+// The engine's answer: the state of the game after the request
+struct ShmReply {
+    enum State : uint8_t { Playing, Won, Lost };
+    int32_t score; // this game's points
+    uint8_t result; // the HangmanRound::GuessResult of a guess
+    uint8_t state;
+    uint8_t misses;
+    uint8_t length; // letters in revealed
+    char revealed[256]; // the word, '_' for hidden letters
+};
+
+// The shared memory itself
+struct ShmSegment {
+    static constexpr uint32_t VERSION = 1;
+    static constexpr size_t RING_SIZE = 64; // messages per direction
+
+    char magic[8];
+    atomic<uint32_t> ready; // set by the engine once the rings are set up
+    uint32_t version;
+    WaitMode mode;
+    SpscRing<ShmRequest, RING_SIZE> requests;
+    SpscRing<ShmReply, RING_SIZE> replies;
+};
+
+// A named block of memory shared between processes
+class SharedSegment {
+private:
+    ShmSegment* segment = nullptr;
+    string name; // the system name of the segment
+    bool owner = false; // the creator removes the name when done
+#ifdef _WIN32
+    HANDLE mapping = nullptr;
+#endif
+
+    bool Map(bool create) {
+#ifdef _WIN32
+        name = "Local\\hangman-" + name;
+        mapping = create ? CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0, sizeof(ShmSegment), name.c_str())
+                         : OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, name.c_str());
+        if (!mapping) return false;
+        segment = static_cast<ShmSegment*>(MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(ShmSegment)));
+#else
+        name = "/hangman-" + name;
+        int fd = create ? shm_open(name.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0600) : shm_open(name.c_str(), O_RDWR, 0);
+        if (fd < 0) return false;
+        if (create && ftruncate(fd, sizeof(ShmSegment)) != 0) {
+            close(fd);
+            shm_unlink(name.c_str());
+            return false;
+        }
+        void* mapped = mmap(nullptr, sizeof(ShmSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        segment = mapped == MAP_FAILED ? nullptr : static_cast<ShmSegment*>(mapped);
+#endif
+        owner = create && segment;
+        return segment != nullptr;
+    }
+
+public:
+    SharedSegment() = default;
+    SharedSegment(const SharedSegment&) = delete;
+    SharedSegment& operator=(const SharedSegment&) = delete;
+    ~SharedSegment() { Close(); }
+
+    // Creates the segment and sets up empty rings
+    bool Create(string_view segment_name, WaitMode mode) {
+        name = segment_name;
+        if (!Map(true)) return false;
+        memcpy(segment->magic, "HGSHM\0\0", 8);
+        segment->version = ShmSegment::VERSION;
+        segment->mode = mode;
+        segment->requests.Init(mode);
+        segment->replies.Init(mode);
+        segment->ready.store(1, memory_order_release);
+        return true;
+    }
+
+    // Opens a segment made by Create, waiting up to timeout_ms for it to be ready
+    bool Open(string_view segment_name, int timeout_ms = 5000) {
+        for (int waited = 0;; waited += 10) {
+            name = segment_name;
+            if (Map(false) && segment->ready.load(memory_order_acquire) && memcmp(segment->magic, "HGSHM", 5) == 0)
+                return segment->version == ShmSegment::VERSION;
+            Close();
+            if (waited >= timeout_ms) return false;
+            this_thread::sleep_for(chrono::milliseconds(10));
+        }
+    }
+
+    void Close() {
+#ifdef _WIN32
+        if (segment) UnmapViewOfFile(segment);
+        if (mapping) CloseHandle(mapping);
+        mapping = nullptr;
+#else
+        if (segment) munmap(segment, sizeof(ShmSegment));
+        if (owner) shm_unlink(name.c_str());
+#endif
+        segment = nullptr;
+        owner = false;
+    }
+
+    ShmSegment* operator->() const { return segment; }
+    bool is_open() const { return segment != nullptr; }
+};
+
+// The engine side: answers one bot's requests until it quits
+template <typename Rules>
+class BasicShmServer {
+private:
+    WordList& wordlist;
+    BasicHangmanRound<Rules> round;
+    ShmReply reply{}; // reused for every answer
+
+    void Fill(typename BasicHangmanRound<Rules>::GuessResult result) {
+        string_view revealed = round.GetRevealed();
+        reply.score = round.GetScore();
+        reply.result = static_cast<uint8_t>(result);
+        reply.state = round.IsWon() ? ShmReply::Won : round.IsLost() ? ShmReply::Lost : ShmReply::Playing;
+        reply.misses = static_cast<uint8_t>(round.GetMisses());
+        reply.length = static_cast<uint8_t>(min<size_t>(revealed.size(), sizeof(reply.revealed)));
+        memcpy(reply.revealed, revealed.data(), reply.length);
+    }
+
+public:
+    BasicShmServer(WordList& words) : wordlist(words) {}
+
+    // Serves the segment; returns the number of requests answered
+    size_t Serve(SharedSegment& segment, const atomic<bool>* stop = nullptr) {
+        size_t answered = 0;
+        ShmRequest request;
+        while (segment->requests.Pop(request, stop)) {
+            if (request.type == ShmRequest::Quit) break;
+            if (request.type == ShmRequest::NewGame) {
+                wordlist.seed(request.seed);
+                round.Start(wordlist.getRandomWord());
+                Fill(BasicHangmanRound<Rules>::GuessResult::Correct);
+            } else {
+                Fill(round.Guess(request.letter));
+            }
+            segment->replies.Push(reply);
+            answered++;
+        }
+        return answered;
+    }
+};
+
+using ShmServer = BasicShmServer<EnglishRules>;
+
+// The bot side: every call is one round trip
+class ShmClient {
+private:
+    SharedSegment segment;
+    ShmRequest request{};
+    ShmReply reply{};
+
+    const ShmReply& RoundTrip() {
+        segment->requests.Push(request);
+        segment->replies.Pop(reply);
+        return reply;
+    }
+
+public:
+    bool Connect(string_view name, int timeout_ms = 5000) { return segment.Open(name, timeout_ms); }
+
+    // Starts a new game, the reply shows the hidden word
+    const ShmReply& NewGame(uint32_t seed) {
+        request.type = ShmRequest::NewGame;
+        request.seed = seed;
+        return RoundTrip();
+    }
+
+    // Guesses a letter of the current game
+    const ShmReply& Guess(char letter) {
+        request.type = ShmRequest::Guess;
+        request.letter = letter;
+        return RoundTrip();
+    }
+
+    // Tells the engine to stop serving
+    void Quit() {
+        request.type = ShmRequest::Quit;
+        segment->requests.Push(request);
+    }
+};
+
+#endif // SHARED_MEMORY_TRANSPORT_HPP
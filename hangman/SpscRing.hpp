@@ -0,0 +1,144 @@
+/*
+this class is a lock-free queue for exactly one producer and one consumer
+it has no pointers and is set up in place, so it can live in memory shared between
+processes; the read and write positions are on their own cache lines, and each side keeps
+a copy of the other side's position so it only reads the shared one when it looks full or empty
+waiting can busy poll, or (on Linux) sleep on a futex after a short spin; the producer
+then bumps a sequence number and wakes the consumer only if it said it was sleeping
+*/
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
+using namespace std;
+
+#ifndef SPSC_RING_HPP
+#define SPSC_RING_HPP
+
+// How a side waits for the other one
+enum class WaitMode : uint32_t { Spin, Futex };
+
+// Tells the core we are spinning, so the other hyperthread gets the pipeline
+inline void CpuRelax() {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    _mm_pause();
+#else
+    this_thread::yield();
+#endif
+}
+
+template <typename T, size_t Capacity>
+class SpscRing {
+    static_assert(is_trivially_copyable_v<T>, "items are copied as bytes");
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "the capacity must be a power of two");
+    static_assert(atomic<uint64_t>::is_always_lock_free && atomic<uint32_t>::is_always_lock_free,
+                  "the positions must work across processes");
+
+    static constexpr int SPIN_LIMIT = 2000; // spins before sleeping on the futex
+
+    // consumer side
+    alignas(64) atomic<uint64_t> head; // the next item to read
+    uint64_t cached_tail; // the consumer's copy of tail
+    // producer side
+    alignas(64) atomic<uint64_t> tail; // the next slot to write
+    uint64_t cached_head; // the producer's copy of head
+    // wake up
+    alignas(64) atomic<uint32_t> sequence; // bumped on every push, the futex word
+    atomic<uint32_t> sleeping; // set while the consumer sleeps on sequence
+    WaitMode mode;
+    alignas(64) T slots[Capacity];
+
+#ifdef __linux__
+    // Sleeps while sequence still has the value seen, for at most 100 ms
+    void Sleep(uint32_t seen) {
+        timespec timeout{0, 100 * 1000 * 1000};
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&sequence), FUTEX_WAIT, seen, &timeout, nullptr, 0);
+    }
+    void Wake() { syscall(SYS_futex, reinterpret_cast<uint32_t*>(&sequence), FUTEX_WAKE, 1, nullptr, nullptr, 0); }
+#else
+    // other systems have no futex across processes, so the consumer yields instead
+    void Sleep(uint32_t) { this_thread::yield(); }
+    void Wake() {}
+#endif
+
+public:
+    // Sets the ring up in place, empty; both sides must agree on the wait mode
+    void Init(WaitMode wait_mode) {
+        head.store(0, memory_order_relaxed);
+        tail.store(0, memory_order_relaxed);
+        cached_tail = cached_head = 0;
+        sequence.store(0, memory_order_relaxed);
+        sleeping.store(0, memory_order_relaxed);
+        mode = wait_mode;
+    }
+
+    // Adds an item, returns false if the ring is full
+    bool TryPush(const T& item) {
+        uint64_t position = tail.load(memory_order_relaxed);
+        if (position - cached_head == Capacity) {
+            cached_head = head.load(memory_order_acquire);
+            if (position - cached_head == Capacity) return false;
+        }
+        slots[position & (Capacity - 1)] = item;
+        tail.store(position + 1, memory_order_release);
+        if (mode == WaitMode::Futex) {
+            sequence.fetch_add(1, memory_order_seq_cst);
+            if (sleeping.load(memory_order_seq_cst)) Wake();
+        }
+        return true;
+    }
+
+    // Takes the oldest item, returns false if the ring is empty
+    bool TryPop(T& item) {
+        uint64_t position = head.load(memory_order_relaxed);
+        if (position == cached_tail) {
+            cached_tail = tail.load(memory_order_acquire);
+            if (position == cached_tail) return false;
+        }
+        item = slots[position & (Capacity - 1)];
+        head.store(position + 1, memory_order_release);
+        return true;
+    }
+
+    // Adds an item, spinning while the ring is full
+    void Push(const T& item) {
+        while (!TryPush(item)) CpuRelax();
+    }
+
+    // Takes the oldest item, waiting for one; gives up and returns false once stop is set
+    bool Pop(T& item, const atomic<bool>* stop = nullptr) {
+        for (int spins = 0;; spins++) {
+            if (TryPop(item)) return true;
+            if (stop && stop->load(memory_order_relaxed)) return false;
+            if (spins < SPIN_LIMIT) {
+                CpuRelax();
+            } else if (mode == WaitMode::Futex) {
+                uint32_t seen = sequence.load(memory_order_seq_cst);
+                sleeping.store(1, memory_order_seq_cst);
+                if (TryPop(item)) {
+                    sleeping.store(0, memory_order_relaxed);
+                    return true;
+                }
+                Sleep(seen);
+                sleeping.store(0, memory_order_relaxed);
+            } else if (spins % 1024 == 0) {
+                this_thread::yield(); // keeps a single core machine from starving the other side
+            } else {
+                CpuRelax();
+            }
+        }
+    }
+};
+
+#endif // SPSC_RING_HPP
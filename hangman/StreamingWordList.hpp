@@ -0,0 +1,129 @@
+/*
+this class draws random words straight from the word file, without loading it
+indexed: one pass at open counts the words and remembers where every BLOCK-th word starts;
+a draw seeks to the block and skips to the word, so memory is 8 bytes per BLOCK words
+reservoir: nothing is kept at all; every draw reads the file once and keeps the k-th word
+with probability 1/k (reservoir sampling), so memory is constant whatever the file size
+words are checked and lowercased like WordIngest does, but repeats are not removed
+*/
+
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "WordIngest.hpp"
+using namespace std;
+
+#ifndef STREAMING_WORD_LIST_HPP
+#define STREAMING_WORD_LIST_HPP
+
+class StreamingWordList {
+public:
+    static constexpr uint64_t BLOCK = 4096; // words per index entry
+
+private:
+    static constexpr size_t MAX_WORD = WordIngest::MAX_WORD; // the same words as an in memory list
+
+    FILE* file = nullptr; // the open word file
+    bool indexed = false; // block index or reservoir sampling
+    uint64_t count = 0; // number of words, when indexed
+    vector<uint64_t> block_offsets; // where every BLOCK-th word starts, when indexed
+    uint64_t position = 0; // offset of the next byte getc returns
+
+    static bool IsSpace(int c) { return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f'; }
+
+    // 64 bit offsets on both platforms, so files over 2 GB seek right where long is 32 bits
+    void Seek(uint64_t offset) {
+#ifdef _WIN32
+        _fseeki64(file, static_cast<__int64>(offset), SEEK_SET);
+#else
+        fseeko(file, static_cast<off_t>(offset), SEEK_SET);
+#endif
+        position = offset;
+    }
+
+    // Reads the next valid word into buffer, lowercased; start is set to where it begins
+    bool NextWord(char* buffer, size_t& length, uint64_t& start) {
+        int c;
+        while (true) {
+            do { c = getc(file); position++; } while (c != EOF && IsSpace(c));
+            if (c == EOF) return false;
+            start = position - 1;
+            length = 0;
+            bool valid = true;
+            for (; c != EOF && !IsSpace(c); c = getc(file), position++) {
+                if (c >= 'A' && c <= 'Z') c += 'a' - 'A';
+                valid &= c >= 'a' && c <= 'z';
+                if (length < MAX_WORD) buffer[length] = static_cast<char>(c);
+                length++;
+            }
+            if (valid && length <= MAX_WORD) return true;
+        }
+    }
+
+public:
+    StreamingWordList() = default;
+    StreamingWordList(const StreamingWordList&) = delete;
+    StreamingWordList& operator=(const StreamingWordList&) = delete;
+    ~StreamingWordList() { if (file) fclose(file); }
+
+    // Opens the word file; with build_index the words are counted and indexed, otherwise draws use reservoir sampling
+    bool Open(const string& filename, bool build_index) {
+        file = fopen(filename.c_str(), "rb");
+        if (!file) return false;
+        indexed = build_index;
+        if (indexed) {
+            char buffer[MAX_WORD];
+            size_t length;
+            uint64_t start;
+            Seek(0);
+            while (NextWord(buffer, length, start)) {
+                if (count % BLOCK == 0) block_offsets.push_back(start);
+                count++;
+            }
+        }
+        return true;
+    }
+
+    // Draws a uniformly random word, or an empty string if the file has none
+    string Draw(mt19937& rng) {
+        char buffer[MAX_WORD];
+        size_t length = 0;
+        uint64_t start;
+        if (indexed) {
+            if (count == 0) return "";
+            uint64_t target = uniform_int_distribution<uint64_t>(0, count - 1)(rng);
+            Seek(block_offsets[target / BLOCK]);
+            for (uint64_t skip = target % BLOCK; skip > 0; skip--) NextWord(buffer, length, start);
+            NextWord(buffer, length, start);
+            return string(buffer, length);
+        }
+
+        string chosen;
+        uint64_t seen = 0;
+        Seek(0);
+        while (NextWord(buffer, length, start)) {
+            seen++;
+            if (uniform_int_distribution<uint64_t>(0, seen - 1)(rng) == 0) chosen.assign(buffer, length);
+        }
+        return chosen;
+    }
+
+    // Checks if a word is in the file, by reading it through
+    bool Contains(string_view word) {
+        char buffer[MAX_WORD];
+        size_t length;
+        uint64_t start;
+        Seek(0);
+        while (NextWord(buffer, length, start))
+            if (string_view(buffer, length) == word) return true;
+        return false;
+    }
+
+    uint64_t size() const { return count; }
+    bool is_open() const { return file != nullptr; }
+};
+
+#endif // STREAMING_WORD_LIST_HPP
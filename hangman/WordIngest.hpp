@@ -0,0 +1,202 @@
+/*
+this class reads a word file in parallel: the mapped file is split into one chunk per core,
+and every chunk is parsed on its own thread
+a word is kept only if it is made of letters; it is lowercased, and duplicates are removed
+in two steps: every chunk first drops its own repeats with a private hash set, then the
+words left go into a lock-free hash set shared by all threads (open addressing, one atomic
+slot per entry), which is then only as big as the distinct words
+when a word appears more than once, the slot keeps its first occurrence, so the result
+is in file order and the same on every run
+*/
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include "MappedFile.hpp"
+#include "AllocTracker.hpp"
+using namespace std;
+
+#ifndef WORD_INGEST_HPP
+#define WORD_INGEST_HPP
+
+class WordIngest {
+public:
+    static constexpr size_t MAX_WORD = 255; // longer tokens are not words, here and in StreamingWordList
+
+private:
+    static constexpr size_t MIN_CHUNK = 1 << 20; // smaller files are not worth another thread
+
+    // A word as found in the file: where it starts and how long it is
+    struct Token {
+        uint64_t offset;
+        uint32_t length;
+    };
+
+    const char* text = nullptr; // the whole file
+    size_t size = 0;
+    vector<atomic<uint64_t>> slots; // the hash set: (offset + 1) << 8 | length, 0 when empty
+    uint64_t mask = 0; // slot count - 1
+
+    static bool IsSpace(char c) { return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f'; }
+    static char Lower(char c) { return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c; }
+    static bool IsLetter(char c) { c = Lower(c); return c >= 'a' && c <= 'z'; }
+
+    static uint64_t Pack(const Token& token) { return ((token.offset + 1) << 8) | token.length; }
+    static Token Unpack(uint64_t value) { return Token{(value >> 8) - 1, static_cast<uint32_t>(value & 0xFF)}; }
+
+    uint64_t Hash(const Token& token) const {
+        uint64_t h = 14695981039346656037ull;
+        for (size_t i = 0; i < token.length; i++) {
+            h ^= static_cast<unsigned char>(Lower(text[token.offset + i]));
+            h *= 1099511628211ull;
+        }
+        return h ^ (h >> 29);
+    }
+
+    bool SameWord(const Token& a, const Token& b) const {
+        if (a.length != b.length) return false;
+        for (size_t i = 0; i < a.length; i++)
+            if (Lower(text[a.offset + i]) != Lower(text[b.offset + i])) return false;
+        return true;
+    }
+
+    // Finds the valid words that start inside [begin, end), without the chunk's own repeats
+    void Tokenize(size_t begin, size_t end, vector<Token>& tokens) const {
+        vector<uint64_t> seen(1024, 0); // private hash set of packed tokens
+        size_t seen_count = 0;
+        auto add = [&](const Token& token) {
+            if (seen_count * 2 >= seen.size()) {
+                vector<uint64_t> bigger(seen.size() * 2, 0);
+                for (uint64_t value : seen) {
+                    if (!value) continue;
+                    uint64_t j = Hash(Unpack(value)) & (bigger.size() - 1);
+                    while (bigger[j]) j = (j + 1) & (bigger.size() - 1);
+                    bigger[j] = value;
+                }
+                seen.swap(bigger);
+            }
+            for (uint64_t j = Hash(token) & (seen.size() - 1);; j = (j + 1) & (seen.size() - 1)) {
+                if (!seen[j]) {
+                    seen[j] = Pack(token);
+                    seen_count++;
+                    tokens.push_back(token);
+                    return;
+                }
+                if (SameWord(Unpack(seen[j]), token)) return;
+            }
+        };
+
+        size_t i = begin;
+        if (i > 0 && !IsSpace(text[i - 1]))
+            while (i < size && !IsSpace(text[i])) i++; // this word belongs to the previous chunk
+        while (i < end) {
+            while (i < size && IsSpace(text[i])) i++;
+            if (i >= end) break;
+            size_t start = i;
+            bool valid = true;
+            while (i < size && !IsSpace(text[i])) valid &= IsLetter(text[i++]);
+            if (valid && i - start <= MAX_WORD) add(Token{start, static_cast<uint32_t>(i - start)});
+        }
+    }
+
+    // Adds a word to the set; if it is already there, the earliest occurrence wins
+    void Insert(const Token& token) {
+        uint64_t mine = Pack(token);
+        for (uint64_t i = Hash(token) & mask;; i = (i + 1) & mask) {
+            uint64_t current = slots[i].load(memory_order_acquire);
+            while (current == 0) {
+                if (slots[i].compare_exchange_weak(current, mine, memory_order_acq_rel, memory_order_acquire)) return;
+            }
+            if (!SameWord(Unpack(current), token)) continue;
+            while (Unpack(current).offset > token.offset) {
+                if (slots[i].compare_exchange_weak(current, mine, memory_order_acq_rel, memory_order_acquire)) return;
+            }
+            return;
+        }
+    }
+
+    // Checks if this occurrence of a word is the one the set kept
+    bool IsFirst(const Token& token) const {
+        for (uint64_t i = Hash(token) & mask;; i = (i + 1) & mask) {
+            Token kept = Unpack(slots[i].load(memory_order_relaxed));
+            if (SameWord(kept, token)) return kept.offset == token.offset;
+        }
+    }
+
+    // Runs work(chunk) for every chunk, one thread each; the threads allocate under the caller's tag
+    template <typename Work>
+    static void ForEachChunk(size_t chunks, Work work) {
+        vector<thread> pool;
+        AllocTag tag = AllocTracker::Current();
+        for (size_t c = 1; c < chunks; c++)
+            pool.emplace_back([&work, tag](size_t chunk) {
+                AllocScope scope(tag);
+                work(chunk);
+            }, c);
+        work(0);
+        for (thread& t : pool) t.join();
+    }
+
+public:
+    // Loads the words of a file, returns false if it cannot be opened
+    bool Load(const string& filename, vector<string>& words, unsigned threads = thread::hardware_concurrency()) {
+        words.clear();
+        MappedFile file;
+        if (!file.Open(filename)) {
+            ifstream exists(filename);
+            return exists.is_open(); // an empty file has no words
+        }
+        text = file.data();
+        size = file.size();
+
+        size_t chunks = max<size_t>(1, min<size_t>(max(threads, 1u), size / MIN_CHUNK + 1));
+        vector<vector<Token>> tokens(chunks);
+        vector<vector<string>> kept(chunks);
+
+        // parse, validate and drop repeats inside each chunk
+        ForEachChunk(chunks, [&](size_t c) {
+            Tokenize(size * c / chunks, size * (c + 1) / chunks, tokens[c]);
+        });
+
+        size_t total = 0;
+        for (const vector<Token>& chunk : tokens) total += chunk.size();
+        size_t slot_count = 1;
+        while (slot_count < total * 2) slot_count <<= 1;
+        slots = vector<atomic<uint64_t>>(slot_count);
+        for (atomic<uint64_t>& slot : slots) slot.store(0, memory_order_relaxed);
+        mask = slot_count - 1;
+
+        // drop repeats across chunks
+        ForEachChunk(chunks, [&](size_t c) {
+            for (const Token& token : tokens[c]) Insert(token);
+        });
+
+        // keep the first occurrences, lowercased
+        ForEachChunk(chunks, [&](size_t c) {
+            for (const Token& token : tokens[c]) {
+                if (!IsFirst(token)) continue;
+                string word(text + token.offset, token.length);
+                for (char& ch : word) ch = Lower(ch);
+                kept[c].push_back(move(word));
+            }
+        });
+
+        size_t unique = 0;
+        for (const vector<string>& chunk : kept) unique += chunk.size();
+        words.reserve(unique);
+        for (vector<string>& chunk : kept)
+            for (string& word : chunk) words.push_back(move(word));
+
+        slots = vector<atomic<uint64_t>>();
+        text = nullptr;
+        size = 0;
+        return true;
+    }
+};
+
+#endif // WORD_INGEST_HPP
@@ -1,42 +1,261 @@
-/* 
-this class loads in the words in the words.txt into a vector
-the getRandomWord fetches a random word from that vector when called
-*/
-
-#include <cstdlib> // 
-#include <ctime> // for time function
-#include <fstream> // for files
-#include <vector>
-#include <iostream>
-
-#ifndef WORDLIST_HPP
-#define WORDLIST_HPP
-using namespace std;
-class WordList {
-private:
-    vector<string> words; // a vector to store our words
-public:
-    WordList(const string& filename) {
-        // opens a file called filename
-        fstream file(filename); 
-        if (!file.is_open()) {
-            cerr << "Error opening file: " << filename << endl;
-            exit(1);
-        }
-
-        // puts every words in the file into vector
-        string word;
-        while (file >> word) {
-            words.push_back(word);
-        }
-        file.close();
-    }
-    string getRandomWord() {
-        
-        // gets random word from the vector of words
-        srand(static_cast<unsigned int>(time(0)));
-        return words[rand() % words.size()];
-    }
-};
-
-#endif // WORDLIST_H
+/* 
+this class loads in the words in the words.txt into a front coded dictionary
+(lowercased, without duplicates or entries that are not plain words; see WordIngest)
+a word's index is its rank in sorted order
+the getRandomWord fetches a random word from that dictionary when called
+if <file>.difficulty exists (written by DifficultyAnalyzer), the measured difficulty
+of every word is loaded too, so words can be ranked without computing anything; a game
+can then ask for easy, medium or hard words, the easiest, middle or hardest third of them
+words can be weighted, so common words come up more often: a <file>.weights file of
+"word weight" lines gives each word its weight (1 if it has none, lines that are not one are
+skipped); without it, a word file where every line is "word weight" ("apple 120") is read the
+same way; weighted draws use an alias table and cost the same as plain ones
+on small devices the list can instead draw straight from the file (see StreamingWordList):
+Streaming keeps a sparse block index, Reservoir keeps nothing; both leave the dictionary empty
+*/
+
+#include <random> // for the word generator
+#include <fstream> // for files
+#include <vector>
+#include <iostream>
+#include <string_view>
+#include <algorithm>
+#include <numeric>
+#include <charconv>
+#include <limits>
+#include <stdexcept>
+#include "PerfectHash.hpp"
+#include "AliasTable.hpp"
+#include "SeenWords.hpp"
+#include "MappedFile.hpp"
+#include "FrontCodedDictionary.hpp"
+#include "WordIngest.hpp"
+#include "StreamingWordList.hpp"
+
+#ifndef WORDLIST_HPP
+#define WORDLIST_HPP
+using namespace std;
+class WordList {
+public:
+    enum class Mode { InMemory, Streaming, Reservoir };
+    enum class Difficulty { Any, Easy, Medium, Hard };
+
+private:
+    FrontCodedDictionary words; // our words, sorted and front coded
+    PerfectHash index; // maps a word to its rank in words, for membership checks
+    mt19937 rng; // draws the random words; seeding it makes the draws repeatable
+    vector<float> expected_misses; // measured difficulty: average misses of the reference solver
+    vector<float> win_probability; // measured difficulty: share of games the reference solver won
+    AliasTable weighted; // weighted draws, empty when the words are not weighted
+    vector<float> draw_weights; // the weight of each word in those draws, empty when they are uniform
+    uint64_t hash = 0; // fingerprint of the words, 0 in the streaming modes
+    Mode mode; // where the words are drawn from
+    mutable StreamingWordList stream; // the word file, in the streaming modes
+
+    // loads the difficulty column, if it has been generated for this word list
+    void LoadDifficulty(const string& filename) {
+        ifstream file(filename);
+        if (!file.is_open()) return;
+
+        expected_misses.assign(words.size(), -1);
+        win_probability.assign(words.size(), -1);
+        string word;
+        float misses, wins;
+        while (file >> word >> misses >> wins) {
+            int i = find(word);
+            if (i < 0) continue;
+            expected_misses[i] = misses;
+            win_probability[i] = wins;
+        }
+    }
+    // splits a "word weight" line; false if the line is anything else
+    static bool ParseWeightLine(string_view line, string_view& word, double& weight) {
+        auto space = [](char c) { return isspace(static_cast<unsigned char>(c)) != 0; };
+        size_t begin = 0, end = line.size();
+        while (begin < end && space(line[begin])) begin++;
+        while (end > begin && space(line[end - 1])) end--;
+        size_t split = begin;
+        while (split < end && !space(line[split])) split++;
+        size_t number = split;
+        while (number < end && space(line[number])) number++;
+        if (split == begin || number == end) return false;
+        auto parsed = from_chars(line.data() + number, line.data() + end, weight);
+        if (parsed.ec != errc() || parsed.ptr != line.data() + end || !(weight >= 0)) return false;
+        word = line.substr(begin, split - begin);
+        return true;
+    }
+
+    // reads "word weight" lines into weights; a word keeps the weight of its first line
+    // every_line: the file counts as weights only if every line that is not blank is one,
+    // otherwise (a sidecar .weights file) lines that are not are skipped
+    // returns false, leaving weights as they were, if the file cannot be read or does not count
+    bool ReadWeights(const string& filename, vector<double>& weights, bool every_line) const {
+        MappedFile file;
+        if (!file.Open(filename)) return false;
+        string_view text(file.data(), file.size());
+
+        vector<pair<int, double>> found;
+        vector<bool> seen(words.size(), false);
+        string lowered;
+        for (size_t pos = 0; pos < text.size();) {
+            size_t end = text.find('\n', pos);
+            if (end == string_view::npos) end = text.size();
+            string_view line = text.substr(pos, end - pos);
+            pos = end + 1;
+            if (all_of(line.begin(), line.end(), [](char c) { return isspace(static_cast<unsigned char>(c)) != 0; }))
+                continue;
+
+            string_view word;
+            double weight;
+            if (!ParseWeightLine(line, word, weight)) {
+                if (every_line) return false; // a plain word list, or one with stray numbers
+                continue;
+            }
+            lowered.assign(word);
+            for (char& c : lowered) c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+            int i = find(lowered);
+            if (i < 0 || seen[i]) continue;
+            seen[i] = true;
+            found.emplace_back(i, weight);
+        }
+        if (found.empty()) return false;
+        for (auto [i, weight] : found) weights[i] = weight;
+        return true;
+    }
+
+    // zeroes the weight of every measured word outside a difficulty band; the bands split the
+    // measured words into thirds, easiest first, and a word never measured stays in every band
+    void KeepBand(Difficulty difficulty, vector<double>& weights) const {
+        vector<uint32_t> order = rankByDifficulty();
+        size_t measured = count_if(order.begin(), order.end(), [this](uint32_t i) { return getExpectedMisses(i) >= 0; });
+        size_t band = static_cast<size_t>(difficulty) - 1;
+        size_t begin = measured * band / 3, end = measured * (band + 1) / 3;
+        for (size_t rank = 0; rank < measured; rank++)
+            if (rank < begin || rank >= end) weights[order[rank]] = 0;
+    }
+
+    // builds the weighted draws from the sidecar file, or from numbers in the word file, keeping
+    // only the words of the difficulty band; with neither, the draws stay uniform
+    void LoadWeights(const string& filename, Difficulty difficulty) {
+        vector<double> weights(words.size(), 1.0);
+        bool has_weights = ReadWeights(filename + ".weights", weights, false) || ReadWeights(filename, weights, true);
+        bool has_band = difficulty != Difficulty::Any && hasDifficulty();
+        if (has_band) KeepBand(difficulty, weights);
+        if (!has_weights && !has_band) return;
+        if (weighted.Build(weights)) draw_weights.assign(weights.begin(), weights.end());
+        // if the band leaves no weight the table stays empty and every word is drawn
+    }
+
+public:
+    // throws runtime_error if the file cannot be read
+    // difficulty picks the band of words to draw from; it needs the difficulty column and the in memory mode
+    WordList(const string& filename, Mode load_mode = Mode::InMemory, Difficulty difficulty = Difficulty::Any)
+        : rng(random_device{}()), mode(load_mode) {
+        if (mode != Mode::InMemory) {
+            if (!stream.Open(filename, mode == Mode::Streaming)) throw runtime_error("Error opening file: " + filename);
+            return;
+        }
+
+        // reads every word in the file called filename, on all cores
+        vector<string> loaded;
+        WordIngest ingest;
+        if (!ingest.Load(filename, loaded)) throw runtime_error("Error opening file: " + filename);
+        sort(loaded.begin(), loaded.end());
+        words.Build(loaded);
+
+        // fingerprints the sorted words (FNV-1a, a newline after each), so data keyed by word rank can check its list
+        hash = 14695981039346656037ull;
+        for (const string& w : loaded) {
+            for (char c : w) hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+            hash = (hash ^ '\n') * 1099511628211ull;
+        }
+
+        // builds the perfect hash once, so later lookups never allocate
+        index.Build(loaded.size(), [&loaded](size_t i) -> string_view { return loaded[i]; });
+
+        LoadDifficulty(filename + ".difficulty");
+        LoadWeights(filename, difficulty);
+    }
+    string getRandomWord() {
+        if (mode != Mode::InMemory) return stream.Draw(rng);
+
+        // gets random word from the dictionary, by weight if the words have weights
+        if (!weighted.empty()) return words.Get(weighted.Sample(rng));
+        return words.Get(uniform_int_distribution<size_t>(0, words.size() - 1)(rng));
+    }
+
+    // gets a random word that seen does not hold yet, and marks it; seen starts over if it was kept for
+    // another word list; the streaming modes cannot skip words
+    string getRandomWord(SeenWords& seen) {
+        if (mode != Mode::InMemory || words.size() == 0) return getRandomWord();
+        if (seen.size() != words.size() || seen.GetDictionary() != hash) seen.Reset(words.size(), hash);
+        size_t i = seen.Draw(rng, [this](mt19937& r) -> size_t {
+            return weighted.empty() ? uniform_int_distribution<size_t>(0, words.size() - 1)(r) : weighted.Sample(r);
+        }, [this](size_t w) -> double { return draw_weights.empty() ? 1.0 : draw_weights[w]; });
+        return words.Get(i);
+    }
+
+    // restarts the random words from a seed
+    void seed(uint32_t value) { rng.seed(value); }
+
+    // returns the position of a word in the list, or -1 if it is not there
+    int find(string_view word) const {
+        uint32_t i = index.Find(word);
+        return i != PerfectHash::npos && words.Equals(i, word) ? static_cast<int>(i) : -1;
+    }
+
+    // checks if a word is in the list; when streaming, this reads the file through
+    bool contains(string_view word) const {
+        if (mode != Mode::InMemory) return stream.Contains(word);
+        return find(word) >= 0;
+    }
+
+    // identifies the word list: two lists have the same fingerprint if they hold the same words,
+    // so their word positions mean the same; 0 in the streaming modes
+    uint64_t fingerprint() const { return hash; }
+
+    // the words in memory; 0 in the streaming modes
+    size_t size() const { return words.size(); }
+    string word(size_t i) const { return words.Get(i); }
+
+    // calls visit(index, word) for every word in order, without decoding the list into memory
+    template <typename Visit>
+    void forEach(Visit visit) const { words.ForEach(visit); }
+
+    // decodes the whole list, for tools that scan every word many times
+    vector<string> getWords() const {
+        vector<string> all;
+        all.reserve(words.size());
+        forEach([&all](size_t, string_view word) { all.emplace_back(word); });
+        return all;
+    }
+
+    // bytes used by the words, the membership table and the weights
+    size_t memoryBytes() const {
+        return words.MemoryBytes() + index.MemoryBytes() + weighted.MemoryBytes() + draw_weights.capacity() * sizeof(float);
+    }
+
+    // checks if draws follow word weights
+    bool isWeighted() const { return !weighted.empty(); }
+
+    // measured difficulty of a word, -1 if it has not been analyzed
+    bool hasDifficulty() const { return !expected_misses.empty(); }
+    float getExpectedMisses(size_t i) const { return hasDifficulty() ? expected_misses[i] : -1; }
+    float getWinProbability(size_t i) const { return hasDifficulty() ? win_probability[i] : -1; }
+
+    // returns the word positions from easiest to hardest, the words never measured last
+    vector<uint32_t> rankByDifficulty() const {
+        vector<uint32_t> order(words.size());
+        iota(order.begin(), order.end(), 0);
+        if (hasDifficulty()) {
+            auto misses = [this](uint32_t i) {
+                float m = getExpectedMisses(i);
+                return m < 0 ? numeric_limits<float>::infinity() : m;
+            };
+            stable_sort(order.begin(), order.end(), [&misses](uint32_t a, uint32_t b) { return misses(a) < misses(b); });
+        }
+        return order;
+    }
+};
+
+#endif // WORDLIST_H
@@ -1,11 +1,293 @@
-#include "Hangman.hpp"
-
-int main() {
-    // Create an instance of the Hangman game
-    Hangman game;
-
-    // Start the game
-    game.PlayGame();
-
-    return 0;
-}
\ No newline at end of file
+#include "Hangman.hpp"
+#include "DifficultyAnalyzer.hpp"
+#include "DecisionTree.hpp"
+#include "PatternIndex.hpp"
+#include "BatchRunner.hpp"
+#include "SharedMemoryTransport.hpp"
+#include "HistoryArchive.hpp"
+#include "BatchGuessEngine.hpp"
+#include <chrono>
+
+// Measures the difficulty of every word and saves it next to the word file
+int AnalyzeWords(const string& word_file) {
+    WordList wordlist(word_file);
+    DifficultyAnalyzer analyzer(wordlist);
+    analyzer.Run();
+    if (!analyzer.Save(word_file + ".difficulty")) {
+        cerr << "Unable to write " << word_file << ".difficulty" << endl;
+        return 1;
+    }
+    cout << "Analyzed " << wordlist.size() << " words into " << word_file << ".difficulty" << endl;
+    return 0;
+}
+
+// Precomputes the best guess for every reachable game state
+int BuildTree(const string& word_file, const string& tree_file) {
+    WordList wordlist(word_file);
+    if (!DecisionTree::Generate(wordlist, tree_file)) {
+        cerr << "Unable to write " << tree_file << endl;
+        return 1;
+    }
+    cout << "Decision tree written to " << tree_file << endl;
+    return 0;
+}
+
+// Lists the words that fit a pattern ('_' for hidden letters) and contain none of the excluded letters
+int MatchWords(const string& pattern, const string& excluded, const string& word_file) {
+    WordList wordlist(word_file);
+    PatternIndex index;
+    index.Build(wordlist);
+    vector<uint32_t> found = index.Match(pattern, PatternIndex::MaskOf(excluded));
+    for (uint32_t i : found) cout << wordlist.word(i) << "\n";
+    cout << found.size() << " words match " << pattern << endl;
+    return 0;
+}
+
+// Plays the scripted games of a file ("-" for stdin), one JSON result line per game
+int RunBatch(const string& script_file, const string& word_file) {
+    ios::sync_with_stdio(false);
+    WordList wordlist(word_file);
+    ifstream file;
+    if (script_file != "-") {
+        file.open(script_file);
+        if (!file.is_open()) {
+            cerr << "Unable to open " << script_file << endl;
+            return 1;
+        }
+    }
+    auto start = chrono::steady_clock::now();
+    BatchRunner runner(wordlist);
+    runner.Run(script_file == "-" ? cin : file);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cerr << "Played " << runner.GetGames() << " games (" << runner.GetErrors() << " bad lines) in " << seconds * 1000
+         << " ms (" << (seconds > 0 ? runner.GetGames() / seconds : 0) << " games/s)" << endl;
+    return runner.GetErrors() ? 1 : 0;
+}
+
+// Serves a bot through a shared memory segment until it quits
+int ServeSharedMemory(const string& name, const string& word_file, WaitMode mode) {
+    WordList wordlist(word_file);
+    SharedSegment segment;
+    if (!segment.Create(name, mode)) {
+        cerr << "Unable to create shared memory " << name << endl;
+        return 1;
+    }
+    ShmServer server(wordlist);
+    cerr << "Serving on shared memory " << name << endl;
+    size_t answered = server.Serve(segment);
+    cerr << "Answered " << answered << " requests" << endl;
+    return 0;
+}
+
+// Plays games against a served engine, guessing letters by frequency, and reports the round trip time
+int RunSharedMemoryBot(const string& name, int games) {
+    ShmClient client;
+    if (!client.Connect(name)) {
+        cerr << "Unable to connect to shared memory " << name << endl;
+        return 1;
+    }
+    const string order = "etaoinshrdlcumwfgypbvkjxqz";
+    size_t trips = 0;
+    int won = 0;
+    auto start = chrono::steady_clock::now();
+    for (int game = 0; game < games; game++) {
+        client.NewGame(static_cast<uint32_t>(game));
+        trips++;
+        for (char letter : order) {
+            const ShmReply& reply = client.Guess(letter);
+            trips++;
+            if (reply.state != ShmReply::Playing) {
+                won += reply.state == ShmReply::Won;
+                break;
+            }
+        }
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    client.Quit();
+    cout << "Played " << games << " games (" << won << " won), " << trips << " round trips, "
+         << seconds / trips * 1e9 << " ns per round trip" << endl;
+    return 0;
+}
+
+// Plays the same games on the batch guess engine and on one HangmanRound per session, guessing
+// letters by frequency, checks that both give the same points and reports the time per guess
+int BenchGuesses(int sessions, const string& word_file) {
+    WordList wordlist(word_file);
+    wordlist.seed(1);
+    BatchGuessEngine engine;
+    vector<HangmanRound> rounds(sessions);
+    for (int i = 0; i < sessions; i++) {
+        string word = wordlist.getRandomWord();
+        engine.Add(word);
+        rounds[i].Start(word);
+    }
+
+    const string order = "etaoinshrdlcumwfgypbvkjxqz";
+    vector<char> letters(sessions);
+    vector<BatchGuessEngine::GuessResult> results(sessions);
+    auto start = chrono::steady_clock::now();
+    for (char letter : order) {
+        fill(letters.begin(), letters.end(), letter);
+        engine.Apply(letters, results);
+    }
+    auto batched = chrono::steady_clock::now();
+    for (char letter : order)
+        for (HangmanRound& round : rounds) round.Guess(letter);
+    auto one_by_one = chrono::steady_clock::now();
+
+    int different = 0;
+    for (int i = 0; i < sessions; i++)
+        different += engine.GetScore(i) != rounds[i].GetScore() || engine.GetMisses(i) != rounds[i].GetMisses();
+    double guesses = double(sessions) * order.size();
+    cout << sessions << " sessions: batched " << chrono::duration<double, nano>(batched - start).count() / guesses
+         << " ns per guess, one by one " << chrono::duration<double, nano>(one_by_one - batched).count() / guesses
+         << " ns per guess, " << different << " sessions scored differently" << endl;
+    return different ? 1 : 0;
+}
+
+// Answers a question about the finished rounds of an archive, like the miss rate of a letter
+// on words of a length over the last days; with no letter it gives the miss rate of every letter
+// only the rounds played with the word file (--words, words.txt by default) are counted
+int QueryHistory(int argc, char* argv[]) {
+    string archive_file = "history.hga", word_file = "words.txt";
+    HistoryFilter filter;
+    for (int i = 2; i < argc; i++) {
+        string option = argv[i];
+        if (option == "--words" && i + 1 < argc) word_file = argv[++i];
+        else if (option == "--length" && i + 1 < argc) filter.length = static_cast<uint32_t>(atoi(argv[++i]));
+        else if (option == "--days" && i + 1 < argc) filter.since = HistoryArchive::Now() - atoll(argv[++i]) * 86400;
+        else if (option == "--letter" && i + 1 < argc) filter.letter = EnglishRules::LetterIndex(argv[++i][0]);
+        else archive_file = option;
+    }
+
+    uint64_t dictionary = WordList(word_file).fingerprint();
+    auto start = chrono::steady_clock::now();
+    HistoryColumns columns;
+    if (!HistoryArchive::Load(archive_file, dictionary, columns)) {
+        cerr << "Unable to open " << archive_file << endl;
+        return 1;
+    }
+    if (columns.other_dictionary)
+        cerr << "Skipped " << columns.other_dictionary << " rounds played with another word list than " << word_file << endl;
+    auto loaded = chrono::steady_clock::now();
+    HistorySummary summary = HistoryArchive::Query(columns, filter);
+    auto queried = chrono::steady_clock::now();
+
+    double rounds = summary.rounds ? static_cast<double>(summary.rounds) : 1;
+    cout << summary.rounds << " of " << columns.size() << " rounds: " << 100 * summary.won / rounds << "% won, "
+         << summary.misses / rounds << " misses, " << summary.guesses / rounds << " guesses, "
+         << summary.score / rounds << " points, " << summary.duration / rounds / 1000 << " s per word" << endl;
+    if (filter.letter >= 0) {
+        cout << "letter " << static_cast<char>('a' + filter.letter) << " missed in " << summary.letter_missed
+             << " of them (" << 100 * summary.letter_missed / rounds << "%)" << endl;
+    } else {
+        for (int letter = 0; letter < EnglishRules::ALPHABET_SIZE; letter++) {
+            filter.letter = letter;
+            HistorySummary guessed = HistoryArchive::Query(columns, filter);
+            if (!guessed.rounds) continue;
+            cout << static_cast<char>('a' + letter) << ": guessed in " << guessed.rounds << ", missed "
+                 << 100.0 * guessed.letter_missed / guessed.rounds << "%" << endl;
+        }
+    }
+    cerr << "Loaded in " << chrono::duration<double, milli>(loaded - start).count() << " ms, queried in "
+         << chrono::duration<double, milli>(queried - loaded).count() << " ms" << endl;
+    return 0;
+}
+
+// Reports how long the game took to show its first screen, and how long it then waited for the words
+void ReportStartup(const Hangman& game) {
+    cerr << "First frame after " << chrono::duration<double, milli>(game.GetStartupTime()).count()
+         << " ms, waited " << chrono::duration<double, milli>(game.GetLoadWait()).count() << " ms for the words" << endl;
+}
+
+// Reports what the session and the whole program allocated, when built with HANGMAN_TRACK_ALLOCS
+void ReportAllocs(const Hangman& game) {
+    if (!AllocTracker::ENABLED) return;
+    game.GetSessionAllocs().Print(cerr, "Allocations this session", game.GetIO().InputCount());
+    AllocTracker::Snapshot().Print(cerr, "Allocations in total");
+}
+
+// Replays a recorded session as fast as possible and reports how long it took
+int ReplaySession(const string& session_file) {
+    Hangman game;
+    if (!game.ReplaySession(session_file)) {
+        cerr << "Unable to replay " << session_file << endl;
+        return 1;
+    }
+    auto start = chrono::steady_clock::now();
+    game.PlayGame();
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    size_t inputs = game.GetIO().InputCount();
+    cerr << "Replayed " << inputs << " inputs in " << seconds * 1000 << " ms ("
+         << (seconds > 0 ? inputs / seconds : 0) << " inputs/s), final score " << game.GetScore() << endl;
+    ReportStartup(game);
+    ReportAllocs(game);
+    return 0;
+}
+
+// Runs the tool or the game the command line asks for
+int Run(int argc, char* argv[]) {
+    // Offline tools
+    if (argc > 1 && string(argv[1]) == "--analyze")
+        return AnalyzeWords(argc > 2 ? argv[2] : "words.txt");
+    if (argc > 1 && string(argv[1]) == "--build-tree")
+        return BuildTree(argc > 2 ? argv[2] : "words.txt", argc > 3 ? argv[3] : "words.tree");
+
+    if (argc > 2 && string(argv[1]) == "--match")
+        return MatchWords(argv[2], argc > 3 ? argv[3] : "", argc > 4 ? argv[4] : "words.txt");
+
+    if (argc > 1 && string(argv[1]) == "--batch")
+        return RunBatch(argc > 2 ? argv[2] : "-", argc > 3 ? argv[3] : "words.txt");
+
+    if (argc > 2 && string(argv[1]) == "--serve-shm") {
+        bool futex = string(argv[argc - 1]) == "--futex";
+        return ServeSharedMemory(argv[2], argc > 3 && string(argv[3]) != "--futex" ? argv[3] : "words.txt",
+                                 futex ? WaitMode::Futex : WaitMode::Spin);
+    }
+    if (argc > 2 && string(argv[1]) == "--shm-bot")
+        return RunSharedMemoryBot(argv[2], argc > 3 ? atoi(argv[3]) : 10000);
+
+    if (argc > 1 && string(argv[1]) == "--guess-bench")
+        return BenchGuesses(argc > 2 ? max(1, atoi(argv[2])) : 10000, argc > 3 ? argv[3] : "words.txt");
+
+    if (argc > 1 && string(argv[1]) == "--query")
+        return QueryHistory(argc, argv);
+
+    if (argc > 2 && string(argv[1]) == "--replay")
+        return ReplaySession(argv[2]);
+
+    // Create an instance of the Hangman game; --low-memory draws words straight from the file,
+    // --difficulty easy|medium|hard draws from that third of the words ranked by --analyze,
+    // --startup-time reports the time to the first screen when the game ends
+    auto has_flag = [argc, argv](const string& flag) { return find(argv + 1, argv + argc, flag) != argv + argc; };
+    bool low_memory = has_flag("--low-memory");
+    WordList::Difficulty difficulty = WordList::Difficulty::Any;
+    for (int i = 1; i + 1 < argc; i++) {
+        if (string(argv[i]) != "--difficulty") continue;
+        string level = argv[i + 1];
+        difficulty = level == "easy" ? WordList::Difficulty::Easy : level == "medium" ? WordList::Difficulty::Medium
+                   : level == "hard" ? WordList::Difficulty::Hard : WordList::Difficulty::Any;
+    }
+    Hangman game(low_memory ? WordList::Mode::Streaming : WordList::Mode::InMemory, difficulty);
+    if (argc > 2 && string(argv[1]) == "--record" && !game.RecordSession(argv[2])) {
+        cerr << "Unable to record to " << argv[2] << endl;
+        return 1;
+    }
+
+    // Start the game
+    game.PlayGame();
+    if (has_flag("--startup-time")) ReportStartup(game);
+    ReportAllocs(game);
+
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    // a word list that cannot be read, even the one loading in the background, ends up here
+    try {
+        return Run(argc, argv);
+    } catch (const exception& error) {
+        cerr << error.what() << endl;
+        return 1;
+    }
+}
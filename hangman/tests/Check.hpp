@@ -0,0 +1,25 @@
+/*
+the one check the tests use: CHECK(condition) prints the file, line and condition when it fails
+and counts the failure; a test's main returns Failures(), so it exits non zero if any failed
+*/
+
+#include <iostream>
+using namespace std;
+
+#ifndef CHECK_HPP
+#define CHECK_HPP
+
+inline int& Failures() {
+    static int failures = 0;
+    return failures;
+}
+
+#define CHECK(condition)                                                                     \
+    do {                                                                                     \
+        if (!(condition)) {                                                                  \
+            cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #condition << endl;    \
+            Failures()++;                                                                    \
+        }                                                                                    \
+    } while (0)
+
+#endif // CHECK_HPP
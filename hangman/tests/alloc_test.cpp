@@ -0,0 +1,62 @@
+/*
+replays a recorded session built with HANGMAN_TRACK_ALLOCS (see the Makefile) and checks that a
+letter guess allocates nothing for the session state or the rendering, once the word is going:
+the counts are taken around every guess that does not end its word
+the session is recorded here, a seed and the inputs, so it replays the same words every time
+*/
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include "../Hangman.hpp"
+#include "Check.hpp"
+using namespace std;
+
+int main() {
+    CHECK(AllocTracker::ENABLED);
+    const string session_file = "alloc_test.session";
+    {
+        ofstream session(session_file);
+        session << "hangman-session 1\nseed 12345\n\n2\nalloc_test\n";
+        const string order = "etaoinshrdlcumwfgypbvkjxqz";
+        for (int game = 0; game < 20; game++) {
+            session << "1\n";
+            for (char letter : order) session << letter << "\n";
+        }
+    }
+
+    WordList words("../words.txt");
+    Hangman game(words);
+    CHECK(game.ReplaySession(session_file));
+    SessionScheduler scheduler;
+    const uint32_t id = game.Start(scheduler);
+    SessionIO& io = game.GetIO();
+
+    // the console host of PlayGame, with the counts taken around each guess
+    size_t guesses = 0;
+    string input;
+    for (scheduler.Run(); scheduler.IsWaiting(id); scheduler.Run()) {
+        if (!io.Pull(input)) {
+            scheduler.Close(id);
+            continue;
+        }
+        const bool playing = !game.GetWordToGuess().empty() && !game.IsWordGuessed() && game.GetGuessesLeft() > 0;
+        const bool letter = input.size() == 1 && EnglishRules::LetterIndex(input[0]) >= 0;
+        const AllocReport before = AllocTracker::Snapshot();
+        scheduler.Deliver(id, input);
+        scheduler.Run();
+        const AllocReport used = AllocTracker::Snapshot() - before;
+        if (!playing || !letter || game.IsWordGuessed() || game.GetGuessesLeft() == 0) continue; // the word ended
+        guesses++;
+        CHECK(used.tags[static_cast<int>(AllocTag::Session)].allocations == 0);
+        CHECK(used.tags[static_cast<int>(AllocTag::Rendering)].allocations == 0);
+    }
+    CHECK(scheduler.size() == 0);
+    CHECK(guesses > 100);
+
+    remove(session_file.c_str());
+    remove("alloc_test.sav");
+    remove("alloc_test.stats");
+    if (!Failures()) cout << "alloc_test passed, " << guesses << " guesses without an allocation" << endl;
+    return Failures();
+}
@@ -0,0 +1,94 @@
+/*
+runs many real game sessions (Hangman, with its menus) on one scheduler and one thread, all
+playing from one shared word list, feeding their inputs round robin as a host would; checks that
+every session is suspended at once, that each reads exactly its own inputs and plays its own
+profile, that closing the input ends them all, and that new sessions reuse the finished ones' slots
+*/
+
+#include <cstdio>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../Hangman.hpp"
+#include "Check.hpp"
+using namespace std;
+
+int main() {
+    const int SESSIONS = 50;
+    WordList words("../words.txt");
+    words.seed(7);
+    SessionScheduler scheduler;
+
+    vector<unique_ptr<Hangman>> games;
+    vector<ostringstream> screens(SESSIONS);
+    vector<vector<string>> scripts(SESSIONS);
+    vector<size_t> next(SESSIONS, 0);
+    vector<uint32_t> ids;
+    const string order = "etaoinshrdlcumwfgypbvkjxqz";
+    for (int i = 0; i < SESSIONS; i++) {
+        games.push_back(make_unique<Hangman>(words));
+        games[i]->GetIO().StartHeadless(screens[i]);
+        ids.push_back(games[i]->Start(scheduler));
+        // press Enter, create profile coroutine_test_<i>, then new games, guessing letters by frequency
+        scripts[i] = {"", "2", "coroutine_test_" + to_string(i)};
+        for (int game = 0; game < 3; game++) {
+            scripts[i].push_back(game == 1 ? "3" : "1");
+            for (size_t letter = 0; letter < order.size(); letter += 1 + (i + game) % 2) scripts[i].push_back(string(1, order[letter]));
+        }
+    }
+
+    scheduler.Run();
+    CHECK(scheduler.size() == SESSIONS);
+    bool all_waiting = true;
+    for (uint32_t id : ids) all_waiting &= scheduler.IsWaiting(id);
+    CHECK(all_waiting); // every session sits at its welcome screen, on the one thread
+
+    // one input per session per turn, until every script is used up
+    for (bool fed = true; fed;) {
+        fed = false;
+        for (int i = 0; i < SESSIONS; i++) {
+            if (next[i] == scripts[i].size() || !scheduler.IsWaiting(ids[i])) continue;
+            scheduler.Deliver(ids[i], scripts[i][next[i]++]);
+            fed = true;
+        }
+        scheduler.Run();
+    }
+    CHECK(scheduler.size() == SESSIONS); // they all wait for more
+
+    for (int i = 0; i < SESSIONS; i++) {
+        const Hangman& game = *games[i];
+        CHECK(next[i] == scripts[i].size());
+        CHECK(game.GetIO().InputCount() == scripts[i].size());
+        CHECK(game.GetProfileName() == "coroutine_test_" + to_string(i));
+        CHECK(game.GetStats().GetWordsWon() + game.GetStats().GetWordsLost() > 0);
+        CHECK(screens[i].str().find("Profile coroutine_test_" + to_string(i) + " created successfully!") != string::npos);
+    }
+
+    for (uint32_t id : ids) scheduler.Close(id);
+    scheduler.Run();
+    CHECK(scheduler.size() == 0);
+    for (int i = 0; i < SESSIONS; i++) CHECK(games[i]->GetIO().HasEnded());
+
+    // finished sessions give their slots to the next ones, so waves of sessions reuse the same slots
+    for (int wave = 0; wave < 3; wave++) {
+        vector<unique_ptr<Hangman>> more;
+        for (int i = 0; i < SESSIONS; i++) {
+            more.push_back(make_unique<Hangman>(words));
+            more[i]->GetIO().StartHeadless(screens[i]);
+            scheduler.Close(more[i]->Start(scheduler)); // ends at its welcome screen
+        }
+        CHECK(scheduler.size() == SESSIONS);
+        scheduler.Run();
+        CHECK(scheduler.size() == 0);
+        CHECK(scheduler.SlotCount() == SESSIONS);
+    }
+
+    games.clear();
+    for (int i = 0; i < SESSIONS; i++) {
+        remove(("coroutine_test_" + to_string(i) + ".sav").c_str());
+        remove(("coroutine_test_" + to_string(i) + ".stats").c_str());
+    }
+    if (!Failures()) cout << "coroutine_session_test passed" << endl;
+    return Failures();
+}
@@ -0,0 +1,71 @@
+/*
+replays one recorded session twice, next to a saved game of the same profile, and checks that
+both replays draw the same screens and end with the same score, that the saved game and
+statistics on disk are neither read nor changed, and that no round goes to the history archive
+*/
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include "../Hangman.hpp"
+#include "Check.hpp"
+using namespace std;
+
+// Replays a session file with the game drawing itself to screen; returns the final score
+static int Replay(WordList& words, const string& session_file, ostringstream& screen, size_t& inputs) {
+    Hangman game(words);
+    CHECK(game.ReplaySession(session_file));
+    game.GetIO().StartHeadless(screen); // still reads the replayed file
+    game.PlayGame();
+    inputs = game.GetIO().InputCount();
+    return game.GetScore();
+}
+
+int main() {
+    const string session_file = "replay_test.session";
+    {
+        // select the profile, load its game, play three new games and save
+        ofstream session(session_file);
+        session << "hangman-session 1\nseed 4242\n\n1\nreplay_test\n2\n";
+        const string order = "etaoinshrdlcumwfgypbvkjxqz";
+        for (int game = 0; game < 3; game++) {
+            session << "1\n";
+            for (char letter : order) session << letter << "\n";
+        }
+        session << "4\n";
+    }
+
+    // a saved game of the same profile, which the replays must not pick up or write over
+    GameSnapshot saved;
+    saved.profile_name = "replay_test";
+    saved.score = 999;
+    saved.guesses_left = 6;
+    saved.word_to_guess = "apple";
+    saved.guessed_word = "a____";
+    CHECK(WriteWholeFile("replay_test.sav", saved.Encode()));
+    remove("replay_test.stats");
+    remove("history.hga");
+
+    WordList words("../words.txt");
+    ostringstream first_screen, second_screen;
+    size_t first_inputs = 0, second_inputs = 0;
+    int first = Replay(words, session_file, first_screen, first_inputs);
+    int second = Replay(words, session_file, second_screen, second_inputs);
+
+    CHECK(first == second);
+    CHECK(first_inputs == second_inputs);
+    CHECK(first_inputs > 50);
+    CHECK(first_screen.str() == second_screen.str());
+    CHECK(first_screen.str().find("Profile replay_test does not exist") != string::npos);
+
+    vector<uint8_t> bytes;
+    CHECK(ReadWholeFile("replay_test.sav", bytes) && bytes == saved.Encode());
+    CHECK(!ReadWholeFile("replay_test.stats", bytes));
+    CHECK(!ReadWholeFile("history.hga", bytes)); // replayed rounds are not archived
+
+    remove(session_file.c_str());
+    remove("replay_test.sav");
+    if (!Failures()) cout << "replay_test passed" << endl;
+    return Failures();
+}
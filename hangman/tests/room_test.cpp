@@ -0,0 +1,105 @@
+/*
+runs many players on threads against one room: each guesses the alphabet in its own order and
+polls the frames as it goes; checks that every letter is accepted exactly once, that the scores
+add up to what the accepted guesses are worth, and that every frame a player sees is a newer
+version, decodes, and agrees with the letters guessed up to it
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../HangmanRoom.hpp"
+#include "Check.hpp"
+using namespace std;
+
+// What a frame says, decoded
+struct Decoded {
+    uint64_t version = 0, letters = 0, misses = 0;
+    string pattern;
+    bool ok = false;
+};
+
+static Decoded Decode(const HangmanRoom::Frame& frame) {
+    Decoded d;
+    ByteReader reader(frame.bytes.data(), frame.bytes.size());
+    uint64_t length = 0, player = 0;
+    if (!reader.GetVarint(d.version) || !reader.GetVarint(d.letters) || !reader.GetVarint(d.misses) ||
+        !reader.GetVarint(length) || length > reader.remaining())
+        return d;
+    d.pattern.resize(length);
+    char letter;
+    d.ok = reader.GetRaw(d.pattern.data(), length) && reader.GetVarint(player) && reader.GetRaw(&letter, 1) &&
+           d.version == frame.version;
+    return d;
+}
+
+// Plays one room with players threads; the word's misses decide if it is solved or lost first
+static void PlayRoom(const string& word, int players, uint32_t seed) {
+    HangmanRoom room(word, players);
+    atomic<int> accepted{0}, correct{0}, incorrect{0}, bad_frames{0}, stale_frames{0};
+
+    vector<thread> threads;
+    for (int t = 0; t < players; t++) {
+        threads.emplace_back([&, t] {
+            int id = room.Join();
+            if (id < 0) return;
+            string order = "abcdefghijklmnopqrstuvwxyz";
+            mt19937 rng(seed + t);
+            shuffle(order.begin(), order.end(), rng);
+            uint32_t last = 0;
+            for (char letter : order) {
+                HangmanRoom::GuessResult result = room.Guess(id, letter);
+                if (result == HangmanRoom::GuessResult::Correct) correct++;
+                if (result == HangmanRoom::GuessResult::Incorrect) incorrect++;
+                if (result == HangmanRoom::GuessResult::Correct || result == HangmanRoom::GuessResult::Incorrect)
+                    accepted++;
+
+                uint32_t before = last;
+                if (const HangmanRoom::Frame* frame = room.Poll(last)) {
+                    Decoded d = Decode(*frame);
+                    if (!d.ok || d.version != last || popcount(d.letters) != static_cast<int>(d.version))
+                        bad_frames++;
+                    for (size_t i = 0; d.ok && i < word.size(); i++)
+                        if ((d.pattern[i] != '_') != ((d.letters >> (word[i] - 'a') & 1) != 0)) bad_frames++;
+                    if (d.version <= before) stale_frames++;
+                }
+            }
+        });
+    }
+    for (thread& t : threads) t.join();
+
+    const HangmanRoom::Frame* final_frame = room.Latest();
+    Decoded d = Decode(*final_frame);
+    CHECK(d.ok);
+    CHECK(static_cast<int>(final_frame->version) == accepted.load());
+    CHECK(static_cast<int>(d.misses) == incorrect.load());
+    CHECK(room.GetMisses() == incorrect.load());
+    CHECK(room.IsOver());
+    CHECK(bad_frames.load() == 0);
+    CHECK(stale_frames.load() == 0);
+    if (room.IsSolved()) CHECK(d.pattern == word);
+
+    // the letter points, plus the word bonus once if it was solved
+    int expected = correct * EnglishRules::CORRECT_LETTER + incorrect * EnglishRules::INCORRECT_LETTER;
+    if (room.IsSolved())
+        expected += static_cast<int>(word.size()) * EnglishRules::WORD_LENGTH_BONUS +
+                    (EnglishRules::MAX_MISSES - incorrect) * EnglishRules::UNUSED_GUESS_BONUS + EnglishRules::WIN_BONUS;
+    int total = 0;
+    for (int p = 0; p < room.GetPlayers(); p++) total += room.GetScore(p);
+    CHECK(total == expected);
+    CHECK(room.GetPlayers() == players);
+}
+
+int main() {
+    for (uint32_t round = 0; round < 50; round++) {
+        PlayRoom("abcdefghijklmnopqrstuvwxyz", 64, round * 1000); // every guess hits: 26 versions
+        PlayRoom("jazz", 64, round * 1000 + 500); // lost or won, depending on the order of the guesses
+    }
+    CHECK(HangmanRoom("word", 1).Join() == 0);
+    if (!Failures()) cout << "room_test passed" << endl;
+    return Failures();
+}
@@ -0,0 +1,132 @@
+/*
+checks the game under other rules than the normal ones: HardRules plays a round, a batch and a
+whole game with its 4 misses and its bonus, and a 40 letter alphabet, whose letter masks take 64
+bits, matches patterns, gives hints and measures difficulty like the normal alphabet does on the
+same words
+*/
+
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include "../Hangman.hpp"
+#include "../BatchGuessEngine.hpp"
+#include "../DifficultyAnalyzer.hpp"
+#include "Check.hpp"
+using namespace std;
+
+// 40 letters, 14 of them before 'a', so 's' to 'z' take the mask bits above 31
+struct WideRules : EnglishRules {
+    static constexpr int ALPHABET_SIZE = 40;
+    static constexpr char FIRST_LETTER = 'a' - 14;
+    using LetterMask = LetterMaskFor<ALPHABET_SIZE>;
+
+    static constexpr int LetterIndex(char c) {
+        int index = c - FIRST_LETTER;
+        return c != '_' && index >= 0 && index < ALPHABET_SIZE ? index : -1; // '_' stays a hidden letter
+    }
+};
+static_assert(sizeof(WideRules::LetterMask) == 8);
+static_assert(WideRules::LetterIndex('z') == 39);
+
+// A letter that is not in word, and not one of the ones already taken
+static char Absent(string_view word, string& taken) {
+    for (char c = 'a'; c <= 'z'; c++) {
+        if (word.find(c) != string_view::npos || taken.find(c) != string::npos) continue;
+        taken += c;
+        return c;
+    }
+    return 0;
+}
+
+// Plays a whole game under HardRules, with the menus: the word is lost at the 4th wrong letter
+static void PlayHardGame(WordList& words) {
+    BasicHangman<HardRules> game(words);
+    ostringstream screen;
+    game.GetIO().StartHeadless(screen);
+    SessionScheduler scheduler;
+    uint32_t session = game.Start(scheduler);
+    for (const char* input : {"", "2", "rules_test", "1"}) {
+        scheduler.Run();
+        scheduler.Deliver(session, input);
+    }
+    scheduler.Run();
+    string word(game.GetWordToGuess()), taken;
+    CHECK(!word.empty() && game.GetGuessesLeft() == HardRules::MAX_MISSES);
+    for (int miss = 1; miss <= HardRules::MAX_MISSES; miss++) {
+        CHECK(game.GetStats().GetWordsLost() == 0);
+        scheduler.Deliver(session, string(1, Absent(word, taken)));
+        scheduler.Run();
+    }
+    CHECK(game.GetStats().GetWordsLost() == 1);
+    CHECK(screen.str().find("Sorry, you ran out of guesses. The word was: " + word) != string::npos);
+    scheduler.Close(session);
+    scheduler.Run();
+    CHECK(scheduler.size() == 0);
+}
+
+int main() {
+    // a round: lost at the 4th miss, and every miss left is worth 20
+    BasicHangmanRound<HardRules> lost;
+    lost.Start("apple");
+    for (char c : string("xyz")) lost.Guess(c);
+    CHECK(!lost.IsOver() && lost.GetGuessesLeft() == 1);
+    lost.Guess('q');
+    CHECK(lost.IsLost());
+
+    BasicHangmanRound<HardRules> won;
+    BasicHangmanRound<EnglishRules> normal;
+    won.Start("apple");
+    normal.Start("apple");
+    for (char c : string("xaple")) {
+        won.Guess(c);
+        normal.Guess(c);
+    }
+    CHECK(won.IsWon() && normal.IsWon());
+    CHECK(won.GetScore() - normal.GetScore() == 3 * HardRules::UNUSED_GUESS_BONUS - 5 * EnglishRules::UNUSED_GUESS_BONUS);
+
+    // a batch scores like the rounds
+    BasicBatchGuessEngine<HardRules> engine;
+    uint32_t id = engine.Add("apple");
+    vector<BasicBatchGuessEngine<HardRules>::GuessResult> results(1);
+    for (char c : string("xaple")) engine.Apply(span<const char>(&c, 1), results);
+    CHECK(engine.IsWon(id) && engine.GetScore(id) == won.GetScore());
+
+    WordList words("../words.txt");
+    words.seed(3);
+    PlayHardGame(words);
+
+    // the wide alphabet: excluding 't' (bit 33) and revealing 's' (bit 32) work as they do normally
+    PatternIndex index;
+    BasicPatternIndex<WideRules> wide_index;
+    index.Build(words);
+    wide_index.Build(words);
+    for (string_view excluded : {"t", "st", "eyz", "aeiou"}) {
+        CHECK(wide_index.Match("_____", BasicPatternIndex<WideRules>::MaskOf(excluded)) ==
+              index.Match("_____", PatternIndex::MaskOf(excluded)));
+        CHECK(wide_index.Match("s____", BasicPatternIndex<WideRules>::MaskOf(excluded)) ==
+              index.Match("s____", PatternIndex::MaskOf(excluded)));
+    }
+    for (string_view pattern : {"_____", "s___s", "__a__", "t______"}) {
+        for (string_view missed : {"", "e", "tyz"}) {
+            CHECK(BasicDecisionTree<WideRules>::ComputeBestLetter(words, wide_index, pattern,
+                      BasicPatternIndex<WideRules>::MaskOf(missed)) ==
+                  DecisionTree::ComputeBestLetter(words, index, pattern, PatternIndex::MaskOf(missed)));
+        }
+    }
+
+    BasicDifficultyAnalyzer<WideRules> wide_analyzer(words, 4);
+    DifficultyAnalyzer analyzer(words, 4);
+    wide_analyzer.Run();
+    analyzer.Run();
+    CHECK(wide_analyzer.Save("rules_test.wide") && analyzer.Save("rules_test.normal"));
+    vector<uint8_t> wide_difficulty, difficulty;
+    CHECK(ReadWholeFile("rules_test.wide", wide_difficulty) && ReadWholeFile("rules_test.normal", difficulty));
+    CHECK(!difficulty.empty() && wide_difficulty == difficulty);
+
+    remove("rules_test.wide");
+    remove("rules_test.normal");
+    remove("rules_test.sav");
+    remove("rules_test.stats");
+    if (!Failures()) cout << "rules_test passed" << endl;
+    return Failures();
+}
@@ -0,0 +1,78 @@
+/*
+checkpoints a host with live and closed sessions, restores it into a new host and checks
+that every session comes back the same; then checks that damaged snapshots are refused
+*/
+
+#include <cstdio>
+#include <string>
+#include "../SessionHost.hpp"
+#include "Check.hpp"
+using namespace std;
+
+// Writes bytes as a snapshot file, with a right CRC so only the content is wrong
+static void WriteSnapshot(const string& filename, ByteWriter& writer) {
+    writer.PutCrc();
+    WriteWholeFile(filename, writer.data());
+}
+
+int main() {
+    const string file = "session_host_test.hgck";
+
+    SessionHost host;
+    uint32_t ann = host.Open("ann", "apple");
+    uint32_t bob = host.Open("bob", "banana");
+    uint32_t cat = host.Open("cat", "cherry");
+    host.Get(ann).round.Guess('p');
+    host.Get(ann).round.Guess('z');
+    host.Get(cat).round.GuessWord("cherry");
+    host.Close(bob); // leaves a closed slot between two live ones
+
+    CHECK(host.Checkpoint(file));
+    CHECK(host.WaitForCheckpoint() == SessionHost::CheckpointState::Succeeded);
+
+    SessionHost restored;
+    CHECK(restored.Restore(file));
+    CHECK(restored.size() == 2);
+    CHECK(restored.IsLive(ann) && restored.IsLive(cat) && !restored.IsLive(bob));
+    host.ForEach([&](uint32_t id, const SessionHost::Session& session) {
+        const SessionHost::Session& copy = restored.Get(id);
+        CHECK(copy.profile == session.profile);
+        CHECK(copy.round.GetWord() == session.round.GetWord());
+        CHECK(copy.round.GetRevealed() == session.round.GetRevealed());
+        CHECK(copy.round.GetMisses() == session.round.GetMisses());
+        CHECK(copy.round.GetGuessesUsed() == session.round.GetGuessesUsed());
+        CHECK(copy.round.GetScore() == session.round.GetScore());
+    });
+    CHECK(restored.Open("dan", "date") == bob); // the closed slot is reused first
+
+    // a slot count larger than the snapshot is refused before anything is allocated
+    ByteWriter huge;
+    huge.PutRaw("HGCK", 4);
+    huge.PutVarint(SessionHost::VERSION);
+    huge.PutVarint(UINT32_MAX);
+    WriteSnapshot(file, huge);
+    CHECK(!restored.Restore(file));
+    CHECK(restored.size() == 3); // the sessions are kept
+
+    // so is a live byte that is neither 0 nor 1, and bytes left after the last slot
+    ByteWriter bad_live;
+    bad_live.PutRaw("HGCK", 4);
+    bad_live.PutVarint(SessionHost::VERSION);
+    bad_live.PutVarint(1);
+    bad_live.PutRaw("\x07", 1);
+    WriteSnapshot(file, bad_live);
+    CHECK(!restored.Restore(file));
+
+    ByteWriter trailing;
+    trailing.PutRaw("HGCK", 4);
+    trailing.PutVarint(SessionHost::VERSION);
+    trailing.PutVarint(1);
+    trailing.PutRaw("\0\0", 2);
+    WriteSnapshot(file, trailing);
+    CHECK(!restored.Restore(file));
+    CHECK(restored.size() == 3);
+
+    remove(file.c_str());
+    if (!Failures()) cout << "session_host_test passed" << endl;
+    return Failures();
+}